@@ -0,0 +1,76 @@
+#ifndef COMPONENT_CONTAINER_COLD_STORAGE_H
+#define COMPONENT_CONTAINER_COLD_STORAGE_H
+
+#include <vector>
+#include <cstdint>
+#include "Footprint.h"
+#include "../../Entity/Entity.h"
+
+namespace cs
+{
+	/**
+	* @brief Block store for components that haven't been accessed lately.
+	*
+	* Components are stored as plain bytes, in blocks of up to 64 KiB that are
+	* (optionally) compressed as a whole with Codec. Loading a value decodes its
+	* block, blocks are released once all their values have been loaded back.
+	*
+	* Access times are tracked per entity in epochs: every sweep of the owning
+	* set advances the epoch, values not touched for `period` epochs are stale.
+	* Iterations of the whole set touch all the values at once.
+	*/
+	class ColdStorage final
+	{
+	public:
+		ColdStorage(std::uint32_t stride, std::uint32_t period, bool compressed);
+
+		void touch(EntityId value);
+		void touch();
+		bool stale(EntityId value) const;
+		void advance();
+
+		void store(const EntityId* values, const std::uint8_t* bytes, std::uint32_t count);
+		void load(EntityId value, void* destination);
+		void peek(EntityId value, void* destination) const;
+		bool contains(EntityId value) const;
+		std::uint32_t size() const;
+		void clear();
+		Footprint footprint() const;
+
+		template <typename Function>
+		void each(Function function);
+
+		template <typename Function>
+		void drain(Function function);
+
+	private:
+		struct Block
+		{
+			std::vector<std::uint8_t> data; // Compressed (or raw) bytes of the components
+			std::vector<EntityId> values; // Owners of the components, Entity::INVALID once loaded
+			std::uint32_t alive = 0U;
+		};
+
+		const std::uint8_t* decode(const Block& block);
+		void release(std::uint32_t index);
+
+	private:
+		static const std::uint32_t BLOCK_SIZE = 0x10000U;
+		static const std::uint32_t NONE = ~std::uint32_t(0);
+
+		std::uint32_t stride;
+		std::uint32_t period;
+		bool compressed;
+		std::uint32_t epoch = 0U;
+		std::uint32_t swept = 0U; // Epoch of the last access to all the values
+		std::uint32_t total = 0U;
+		std::vector<std::uint32_t> stamps; // Epoch of the last access, indexed by entity
+		std::vector<std::uint32_t> blocks; // Block of each value, indexed by entity
+		std::vector<std::uint32_t> slots; // Slot of each value within its block, indexed by entity
+		std::vector<Block> storage;
+		std::vector<std::uint32_t> released; // Blocks that can be reused
+		std::vector<std::uint8_t> scratch; // Decoded block, kept around to spare allocations
+	};
+}
+
+#endif
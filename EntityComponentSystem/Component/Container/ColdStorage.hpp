@@ -0,0 +1,253 @@
+#ifndef COMPONENT_CONTAINER_COLD_STORAGE_IMPL
+#define COMPONENT_CONTAINER_COLD_STORAGE_IMPL
+
+#include <cstring>
+#include <cassert>
+#include <utility>
+#include <algorithm>
+#include "ColdStorage.h"
+#include "../../Type/Codec.hpp"
+
+namespace cs
+{
+	const std::uint32_t ColdStorage::BLOCK_SIZE;
+	const std::uint32_t ColdStorage::NONE;
+
+	/**
+	* @param stride Size of a single component, in bytes.
+	* @param period Number of epochs after which untouched values are stale.
+	* @param compressed Whether blocks are compressed or stored as they are.
+	*/
+	ColdStorage::ColdStorage(std::uint32_t stride, std::uint32_t period, bool compressed)
+		: stride(stride)
+		, period(period)
+		, compressed(compressed)
+	{}
+
+	/**
+	* @brief Marks a value as accessed during the current epoch.
+	*/
+	void ColdStorage::touch(EntityId value) {
+		const auto entity = value & Entity::ID_MASK;
+
+		if (entity >= stamps.size()) {
+			stamps.resize(entity + 1U, epoch);
+		}
+
+		stamps[entity] = epoch;
+	}
+
+	/**
+	* @brief Marks all the values as accessed during the current epoch.
+	*/
+	void ColdStorage::touch() {
+		swept = epoch;
+	}
+
+	/**
+	* @brief Returns true if a value hasn't been accessed for a whole period.
+	*
+	* Values never touched count as accessed when the tracking started.
+	*/
+	bool ColdStorage::stale(EntityId value) const {
+		const auto entity = value & Entity::ID_MASK;
+		const auto stamp = entity < stamps.size() ? stamps[entity] : 0U;
+		return epoch - std::max(stamp, swept) >= period;
+	}
+
+	void ColdStorage::advance() {
+		++epoch;
+	}
+
+	/**
+	* @brief Stores a bunch of components, laid out one after the other.
+	*
+	* @warning
+	* Values must not be part of the storage already.
+	*
+	* @param values Owners of the components.
+	* @param bytes Components, `count * stride` bytes.
+	* @param count Number of components.
+	*/
+	void ColdStorage::store(const EntityId* values, const std::uint8_t* bytes, std::uint32_t count) {
+		const auto capacity = std::max(1U, BLOCK_SIZE / stride);
+
+		for (std::uint32_t first = 0U; first < count; first += capacity) {
+			const auto length = std::min(capacity, count - first);
+			auto index = std::uint32_t(storage.size());
+
+			if (released.empty()) {
+				storage.emplace_back();
+			}
+			else {
+				index = released.back();
+				released.pop_back();
+			}
+
+			auto& block = storage[index];
+			const auto begin = bytes + std::size_t(first) * stride;
+			const auto end = begin + std::size_t(length) * stride;
+
+			if (compressed) {
+				Codec::compress(begin, end - begin, block.data);
+			}
+			else {
+				block.data.assign(begin, end);
+			}
+
+			block.data.shrink_to_fit();
+			block.values.assign(values + first, values + first + length);
+			block.alive = length;
+
+			for (std::uint32_t slot = 0U; slot < length; ++slot) {
+				const auto entity = values[first + slot] & Entity::ID_MASK;
+
+				if (entity >= blocks.size()) {
+					blocks.resize(entity + 1U, NONE);
+					slots.resize(entity + 1U, 0U);
+				}
+
+				blocks[entity] = index;
+				slots[entity] = slot;
+			}
+		}
+
+		total += count;
+	}
+
+	/**
+	* @brief Copies the component of a value to the given destination and
+	* removes the value from the storage.
+	*
+	* @warning
+	* Attempting to load a value that isn't part of the storage results in
+	* undefined behavior.<br/>
+	* An assertion will abort the execution at runtime in debug mode in that case.
+	*/
+	void ColdStorage::load(EntityId value, void* destination) {
+		assert(contains(value));
+		const auto entity = value & Entity::ID_MASK;
+		const auto index = blocks[entity];
+		auto& block = storage[index];
+
+		std::memcpy(destination, decode(block) + std::size_t(slots[entity]) * stride, stride);
+
+		block.values[slots[entity]] = Entity::INVALID;
+		blocks[entity] = NONE;
+		--total;
+
+		if (!--block.alive) {
+			release(index);
+		}
+	}
+
+	/**
+	* @brief Copies the component of a value to the given destination, the value
+	* stays in the storage.
+	*
+	* Blocks are decoded into a buffer of their own, thus storages of sets
+	* shared by forks can be read from several threads.
+	*/
+	void ColdStorage::peek(EntityId value, void* destination) const {
+		assert(contains(value));
+		const auto entity = value & Entity::ID_MASK;
+		const auto& block = storage[blocks[entity]];
+		const auto offset = std::size_t(slots[entity]) * stride;
+
+		if (compressed) {
+			auto bytes = std::vector<std::uint8_t>();
+
+			Codec::decompress(block.data.data(), block.data.size(), bytes);
+			std::memcpy(destination, bytes.data() + offset, stride);
+		}
+		else {
+			std::memcpy(destination, block.data.data() + offset, stride);
+		}
+	}
+
+	bool ColdStorage::contains(EntityId value) const {
+		const auto entity = value & Entity::ID_MASK;
+		return entity < blocks.size() && blocks[entity] != NONE && storage[blocks[entity]].values[slots[entity]] == value;
+	}
+
+	std::uint32_t ColdStorage::size() const {
+		return total;
+	}
+
+	void ColdStorage::clear() {
+		storage.clear();
+		released.clear();
+		blocks.clear();
+		slots.clear();
+		total = 0U;
+	}
+
+	Footprint ColdStorage::footprint() const {
+		auto footprint = Footprint();
+
+		for (auto&& block : storage) {
+			footprint.cold += block.data.capacity() + block.values.capacity() * sizeof(EntityId);
+		}
+
+		footprint.sparse += (stamps.capacity() + blocks.capacity() + slots.capacity()) * sizeof(std::uint32_t);
+		footprint.slack += scratch.capacity();
+
+		return footprint;
+	}
+
+	/**
+	* @brief Visits all the values, each block is decoded only once.
+	*
+	* The signature of the function should be equivalent to the following:
+	*
+	* @code{.cpp}
+	* void(EntityId, const std::uint8_t*);
+	* @endcode
+	*/
+	template <typename Function>
+	void ColdStorage::each(Function function) {
+		for (auto&& block : storage) {
+			if (block.alive) {
+				const auto bytes = decode(block);
+
+				for (std::uint32_t slot = 0U; slot < block.values.size(); ++slot) {
+					if (block.values[slot] != Entity::INVALID) {
+						function(block.values[slot], bytes + std::size_t(slot) * stride);
+					}
+				}
+			}
+		}
+	}
+
+	/**
+	* @brief Loads all the values at once, then empties the storage.
+	*
+	* The function is the same as the one of `each`.
+	*/
+	template <typename Function>
+	void ColdStorage::drain(Function function) {
+		each(std::move(function));
+		clear();
+	}
+
+	const std::uint8_t* ColdStorage::decode(const Block& block) {
+		if (!compressed) {
+			return block.data.data();
+		}
+
+		scratch.clear();
+		Codec::decompress(block.data.data(), block.data.size(), scratch);
+
+		return scratch.data();
+	}
+
+	void ColdStorage::release(std::uint32_t index) {
+		auto& block = storage[index];
+
+		block.data = std::vector<std::uint8_t>();
+		block.values = std::vector<EntityId>();
+		released.push_back(index);
+	}
+}
+
+#endif
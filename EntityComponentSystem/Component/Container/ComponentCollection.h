@@ -2,6 +2,18 @@
 #define COMPONENT_CONTAINER_COMPONENT_SET_H
 
 #include <vector>
+#include <memory>
+#include <utility>
+#include <cstdint>
+#include <cassert>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+#include "Footprint.h"
+#include "ColdStorage.h"
+#include "ComponentListener.h"
+#include "../../Entity/Entity.h"
 
 namespace cs
 {
@@ -11,8 +23,8 @@ namespace cs
 	class Collection
 	{
 	public:
-		using Iterator = std::vector<std::uint32_t>::iterator;
-		using IteratorConst = std::vector<std::uint32_t>::const_iterator;
+		using Iterator = std::vector<EntityId>::iterator;
+		using IteratorConst = std::vector<EntityId>::const_iterator;
 
 		Collection() = default;
 		Collection(const Collection&) = delete; // No copying
@@ -22,12 +34,35 @@ namespace cs
 		virtual bool empty() const;
 		virtual void clear(); // Overriden
 		virtual void resize(std::uint32_t capacity);  // Overriden
-		virtual bool add(std::uint32_t value);
-		virtual bool remove(std::uint32_t value);  // Overriden
-		virtual bool contains(std::uint32_t value) const;
+		virtual void reserve(std::uint32_t capacity); // Overriden
+		virtual void shrink_to_fit(); // Overriden
+		virtual Footprint footprint() const; // Overriden
+		virtual void compact(); // Overriden
+		virtual bool thaw(EntityId value); // Overriden
+		virtual void thaw(); // Overriden
+		virtual bool frozen(EntityId value) const; // Overriden
+		virtual void flip(); // Overriden
+		virtual void mirror(const Collection& other); // Overriden
+		virtual bool add(EntityId value);
+		virtual bool remove(EntityId value);  // Overriden
+		virtual bool contains(EntityId value) const;
+		virtual void swap(std::uint32_t lhs, std::uint32_t rhs); // Overriden
+		virtual void merge(Collection& other, const std::vector<EntityId>& table); // Overriden
+		virtual void transfer(EntityId value, Collection& destination, EntityId id); // Overriden
+		virtual std::unique_ptr<Collection> create() const; // Overriden
+		virtual std::unique_ptr<Collection> clone() const; // Overriden
+		virtual void replicate(EntityId value, Collection& destination, const std::vector<EntityId>& ids); // Overriden
+
+		void respect(const Collection& other);
 
 		std::uint32_t size() const;
-		std::uint32_t* data();
+		std::uint32_t span() const;
+		EntityId find(std::uint32_t entity) const;
+		std::uint32_t tombstones() const;
+		std::uint64_t revision() const;
+		void modify();
+		EntityId* data();
+		const EntityId* data() const;
 
 		Iterator begin();
 		Iterator end();
@@ -35,9 +70,14 @@ namespace cs
 		IteratorConst end() const;
 
 	protected:
-		static const int OCCUPIED = 0x01000000;
-		std::vector<std::uint32_t> values; // Where the actual values are stored (dense set)
-		std::vector<std::uint32_t> indices; // Where the indices to values are stored (sparse set)
+		void append(const std::vector<EntityId>& ids);
+		std::uint32_t position(EntityId value) const;
+
+	protected:
+		std::vector<EntityId> values; // Where the actual values are stored (dense set)
+		std::vector<std::uint32_t> indices; // Where the indices to values are stored (sparse set), indexed by entity
+		std::uint32_t dead = 0U; // Tombstones within the packed array, see ComponentCollection::stabilize
+		std::uint64_t changes = 0U; // Bumped on every modification, see revision
 	};
 
 	/**
@@ -57,6 +97,30 @@ namespace cs
 	* iterate directly the internal packed array (see `raw` and `size` member
 	* functions for that). Use `begin` and `end` instead.
 	*
+	* @note
+	* Sets can switch to stable removal (see `stabilize`): removed values leave
+	* a tombstone (`Entity::INVALID`) in the packed array instead of being
+	* replaced by the last one, so the order of the remaining ones is preserved.
+	* Tombstones are skipped by views and are swept away in a single pass by
+	* `compact`, which also destroys the components they hold.
+	*
+	* @note
+	* Sets of trivially copyable components can enable a cold tier (see `tier`).
+	* Each `freeze` moves the components that haven't been touched for a while
+	* into a ColdStorage, out of the packed arrays and thus out of any iteration.
+	* Touching a frozen component (`touch`, `emplace`, `replace`, `remove`)
+	* brings it back first. Views of an EntityManager thaw and touch the whole
+	* set, thus only components accessed by identifier stay frozen. Listeners
+	* keep seeing frozen components as part of the set, the ones brought back
+	* are reported as replaced since they live at a new address.
+	*
+	* @note
+	* Sets of copy assignable components can be double buffered (see `buffer`).
+	* The set itself is the back buffer and is modified as usual, the front one
+	* (see `buffered`) is a read-only copy refreshed by `flip` only. Readers on
+	* other threads can use the front buffer without locks as long as they don't
+	* overlap with `flip`.
+	*
 	* @tparam Component Type of component assigned to the entities.
 	*/
 	template <typename Component>
@@ -67,18 +131,77 @@ namespace cs
 		ComponentCollection(const ComponentCollection&) = delete;
 		ComponentCollection(ComponentCollection&&) = default;
 
+		bool empty() const override;
 		void clear() override;
 		void resize(std::uint32_t capacity) override;
-		bool reset(std::uint32_t value);
-		bool remove(std::uint32_t value) override;
-		bool add(std::uint32_t value, const Component& component);
-		bool update(std::uint32_t value, const Component& component);
-		void accomodate(std::uint32_t value, const Component& component);
+		void reserve(std::uint32_t capacity) override;
+		void shrink_to_fit() override;
+		Footprint footprint() const override;
+		void compact() override;
+		void stabilize(bool enabled);
+		bool stable() const;
+		void tier(std::uint32_t period, bool compressed);
+		std::uint32_t freeze();
+		bool thaw(EntityId value) override;
+		void thaw() override;
+		bool frozen(EntityId value) const override;
+		std::uint32_t frozen() const;
+		void touch(EntityId value);
+		void touch();
+		void buffer(bool enabled);
+		void flip() override;
+		const ComponentCollection* buffered() const;
+		void mirror(const Collection& other) override;
+		bool reset(EntityId value);
+		bool remove(EntityId value) override;
+		void swap(std::uint32_t lhs, std::uint32_t rhs) override;
+		void merge(Collection& other, const std::vector<EntityId>& table) override;
+		void transfer(EntityId value, Collection& destination, EntityId id) override;
+		std::unique_ptr<Collection> create() const override;
+		std::unique_ptr<Collection> clone() const override;
+		void replicate(EntityId value, Collection& destination, const std::vector<EntityId>& ids) override;
+		bool add(EntityId value, const Component& component);
+		bool add(EntityId value, Component&& component);
+		bool update(EntityId value, const Component& component);
+		bool update(EntityId value, Component&& component);
+		void accomodate(EntityId value, const Component& component);
+		void accomodate(EntityId value, Component&& component);
+
+		template <typename... Args>
+		Component& emplace(EntityId value, Args&&... args);
+
+		template <typename... Args>
+		Component& replace(EntityId value, Args&&... args);
+
+		Component& get(EntityId value);
+		const Component& get(EntityId value) const;
+		Component* raw();
+		const Component* raw() const;
 
-		Component& get(std::uint32_t value);
+		template <typename Compare>
+		void sort(Compare compare);
+
+		void listen(ComponentListener<Component>* listener);
+		void unlisten(ComponentListener<Component>* listener);
+		void report(ComponentListener<Component>& listener);
+
+	private:
+		void copy(EntityId value, ComponentCollection& destination, const std::vector<EntityId>& ids, std::true_type);
+		void copy(EntityId value, ComponentCollection& destination, const std::vector<EntityId>& ids, std::false_type);
+		void discard(EntityId value);
+		void restore(EntityId value, const void* bytes, std::true_type);
+		void restore(EntityId value, const void* bytes, std::false_type);
+		std::uint32_t freeze(std::true_type);
+		std::uint32_t freeze(std::false_type);
+		void mirror(const ComponentCollection& source, std::true_type);
+		void mirror(const ComponentCollection& source, std::false_type);
 
 	private:
+		bool tombstoning = false;
+		std::unique_ptr<ColdStorage> cold;
+		std::unique_ptr<ComponentCollection> front;
 		std::vector<Component> components;
+		std::vector<ComponentListener<Component>*> listeners;
 	};
 }
 
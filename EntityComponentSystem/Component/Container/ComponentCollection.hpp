@@ -2,64 +2,348 @@
 #define COMPONENT_CONTAINER_COMPONENT_SET_IMPL
 
 #include "ComponentCollection.h"
+#include "ColdStorage.hpp"
 
 namespace cs
 {
 	void Collection::clear() {
 		values.clear();
 		indices.clear();
+		dead = 0U;
+		++changes;
 	}
 
 	void Collection::resize(std::uint32_t capacity) {
 		values.resize(capacity);
 		indices.resize(capacity);
+		++changes;
+	}
+
+	void Collection::reserve(std::uint32_t capacity) {
+		values.reserve(capacity);
+	}
+
+	/**
+	* @brief Releases the memory that isn't in use.
+	*
+	* The sparse array is trimmed past the highest entity in the set, then both
+	* arrays give their unused capacity back.
+	*/
+	void Collection::shrink_to_fit() {
+		auto last = EntityId(0);
+
+		for (auto value : values) {
+			last = std::max(last, (value & Entity::ID_MASK) + 1U);
+		}
+
+		indices.resize(last);
+		indices.shrink_to_fit();
+		values.shrink_to_fit();
+	}
+
+	Footprint Collection::footprint() const {
+		Footprint footprint;
+
+		footprint.dense = values.size() * sizeof(EntityId);
+		footprint.sparse = indices.capacity() * sizeof(std::uint32_t);
+		footprint.slack = (values.capacity() - values.size()) * sizeof(EntityId);
+
+		return footprint;
+	}
+
+	/**
+	* @brief Sweeps the tombstones away, sets that don't leave any do nothing.
+	*/
+	void Collection::compact() {}
+
+	/**
+	* @brief Brings a value back from the cold tier, sets without one do nothing.
+	* @return True if the value has been brought back, false otherwise.
+	*/
+	bool Collection::thaw(EntityId) {
+		return false;
+	}
+
+	/**
+	* @brief Brings all the values back from the cold tier, sets without one do
+	* nothing.
+	*/
+	void Collection::thaw() {}
+
+	/**
+	* @brief Returns true if a value sits in the cold tier, sets without one
+	* never freeze anything.
+	*/
+	bool Collection::frozen(EntityId) const {
+		return false;
+	}
+
+	/**
+	* @brief Refreshes the front buffer, sets without one do nothing.
+	*/
+	void Collection::flip() {}
+
+	/**
+	* @brief Turns this set into a copy of another set of the same type.
+	*
+	* Arrays are copied over the previous ones, thus the set doesn't allocate
+	* once it has reached the size of the other one.
+	*/
+	void Collection::mirror(const Collection& other) {
+		values = other.values;
+		indices = other.indices;
+		dead = other.dead;
+		++changes;
 	}
 
 	bool Collection::empty() const {
 		return values.empty();
 	}
 
-	bool Collection::add(std::uint32_t value) {
+	bool Collection::add(EntityId value) {
 		auto exists = contains(value);
 
 		// Duplicates can not be stored, otherwise it'll mess the index array
 		if (!exists) {
-			if (value >= indices.size()) {
-				indices.resize(value + 1U);
+			const auto entity = value & Entity::ID_MASK;
+
+			if (entity >= indices.size()) {
+				indices.resize(entity + 1U);
 			}
-			indices[value] = values.size() | OCCUPIED;
+
+			indices[entity] = std::uint32_t(values.size());
 			values.push_back(value);
+			++changes;
 		}
 
 		return !exists;
 	}
 
-	bool Collection::remove(std::uint32_t value) {
+	bool Collection::remove(EntityId value) {
 		auto exists = contains(value);
 
 		if (exists) {
 			const auto last = values.back();
-			const auto index = indices[value] & ~OCCUPIED;
+			const auto index = position(value);
 
-			indices[last] = index | OCCUPIED;
-			indices[value] = 0U;
+			indices[last & Entity::ID_MASK] = index;
+			indices[value & Entity::ID_MASK] = 0U;
 
 			values[index] = last;
 			values.pop_back();
+			++changes;
 		}
 
 		return exists;
 	}
 
-	bool Collection::contains(std::uint32_t value) const {
-		return value < indices.size() && (indices[value] & OCCUPIED) != 0U;
+	bool Collection::contains(EntityId value) const {
+		const auto entity = value & Entity::ID_MASK;
+
+		// Positions aren't flagged: the packed array tells whether they are in use and for which version
+		return entity < indices.size() && indices[entity] < values.size() && values[indices[entity]] == value;
+	}
+
+	/**
+	* @brief Swaps two values by their positions in the packed array.
+	* @param lhs A valid position within the packed array.
+	* @param rhs A valid position within the packed array.
+	*/
+	void Collection::swap(std::uint32_t lhs, std::uint32_t rhs) {
+		std::swap(values[lhs], values[rhs]);
+		indices[values[lhs] & Entity::ID_MASK] = lhs;
+		indices[values[rhs] & Entity::ID_MASK] = rhs;
+		++changes;
+	}
+
+	/**
+	* @brief Sorts this set so that it follows the order of another set.
+	*
+	* Values shared by both sets are moved to the front of the packed array, in
+	* the same relative order they have in the other set. All the remaining values
+	* are left at the back in no particular order.
+	*
+	* @param other The set whose order must be respected.
+	*/
+	void Collection::respect(const Collection& other) {
+		auto offset = std::uint32_t(0);
+
+		compact();
+
+		for (auto value : other) {
+			if (contains(value)) {
+				const auto index = position(value);
+
+				if (index != offset) {
+					swap(offset, index);
+				}
+
+				++offset;
+			}
+		}
+	}
+
+	/**
+	* @brief Appends all the values of another set, translating them on the way.
+	*
+	* Values are appended in the same order they have in the other set, which is
+	* left empty afterwards.
+	*
+	* @warning
+	* Translated values must not be part of this set already.
+	*
+	* @param other A set of the same type, usually owned by another manager.
+	* @param table Translation table, indexed by entity (version excluded).
+	*/
+	void Collection::merge(Collection& other, const std::vector<EntityId>& table) {
+		values.reserve(values.size() + other.values.size());
+
+		for (auto value : other.values) {
+			const auto id = table[value & Entity::ID_MASK];
+
+			assert(!contains(id));
+
+			if ((id & Entity::ID_MASK) >= indices.size()) {
+				indices.resize((id & Entity::ID_MASK) + 1U);
+			}
+
+			indices[id & Entity::ID_MASK] = std::uint32_t(values.size());
+			values.push_back(id);
+		}
+
+		++changes;
+		other.clear();
+	}
+
+	/**
+	* @brief Moves a value to another set of the same type, under a new identifier.
+	*/
+	void Collection::transfer(EntityId value, Collection& destination, EntityId id) {
+		destination.add(id);
+		remove(value);
 	}
 
+	/**
+	* @brief Creates a new empty set of the same type.
+	*/
+	std::unique_ptr<Collection> Collection::create() const {
+		return std::make_unique<Collection>();
+	}
+
+	/**
+	* @brief Creates a copy of the set, listeners aside.
+	*/
+	std::unique_ptr<Collection> Collection::clone() const {
+		auto copy = create();
+		copy->mirror(*this);
+		return copy;
+	}
+
+	/**
+	* @brief Replicates a value into another set of the same type, once per identifier.
+	*
+	* The destination can be this set as well. Identifiers must not be part of
+	* the destination already.
+	*/
+	void Collection::replicate(EntityId, Collection& destination, const std::vector<EntityId>& ids) {
+		destination.append(ids);
+	}
+
+	/**
+	* @brief Adds a bunch of values at once, growing the underlying arrays only once.
+	*/
+	void Collection::append(const std::vector<EntityId>& ids) {
+		if (!ids.empty()) {
+			auto last = EntityId(0);
+
+			for (auto id : ids) {
+				last = std::max(last, id & Entity::ID_MASK);
+			}
+
+			if (last >= indices.size()) {
+				indices.resize(last + 1U);
+			}
+
+			values.reserve(values.size() + ids.size());
+
+			for (auto id : ids) {
+				assert(!contains(id));
+				indices[id & Entity::ID_MASK] = std::uint32_t(values.size());
+				values.push_back(id);
+			}
+
+			++changes;
+		}
+	}
+
+	/**
+	* @brief Returns the position of a value within the packed array.
+	*
+	* @warning
+	* Attempting to use a value that isn't part of the set results in undefined
+	* behavior.
+	*/
+	std::uint32_t Collection::position(EntityId value) const {
+		return indices[value & Entity::ID_MASK];
+	}
+
+	/**
+	* @brief Returns the number of elements of the packed array, tombstones included.
+	*/
 	std::uint32_t Collection::size() const {
 		return values.size();
 	}
 
-	std::uint32_t* Collection::data() {
+	/**
+	* @brief Returns the number of elements of the sparse array, an upper bound
+	* of the entities (version excluded) within the set.
+	*/
+	std::uint32_t Collection::span() const {
+		return indices.size();
+	}
+
+	/**
+	* @brief Returns the value stored for an entity (version excluded),
+	* `Entity::INVALID` if the set doesn't contain any.
+	*/
+	EntityId Collection::find(std::uint32_t entity) const {
+		if (entity < indices.size() && indices[entity] < values.size()) {
+			const auto value = values[indices[entity]];
+			return (value & Entity::ID_MASK) == entity ? value : Entity::INVALID;
+		}
+
+		return Entity::INVALID;
+	}
+
+	/**
+	* @brief Returns the number of tombstones within the packed array.
+	*/
+	std::uint32_t Collection::tombstones() const {
+		return dead;
+	}
+
+	/**
+	* @brief Returns a counter that changes whenever the set is modified.
+	*
+	* Structural changes and replacements bump it on their own. Components
+	* modified in place through a reference don't, use `modify` for that.
+	*/
+	std::uint64_t Collection::revision() const {
+		return changes;
+	}
+
+	/**
+	* @brief Flags the set as modified, see `revision`.
+	*/
+	void Collection::modify() {
+		++changes;
+	}
+
+	EntityId* Collection::data() {
+		return values.data();
+	}
+
+	const EntityId* Collection::data() const {
 		return values.data();
 	}
 
@@ -81,8 +365,16 @@ namespace cs
 
 	template <typename Component>
 	void ComponentCollection<Component>::clear() {
+		if (cold) {
+			cold->clear();
+		}
+
 		components.clear();
 		Collection::clear();
+
+		for (auto listener : listeners) {
+			listener->cleared();
+		}
 	}
 
 	template <typename Component>
@@ -92,40 +384,671 @@ namespace cs
 	}
 
 	template <typename Component>
-	bool ComponentCollection<Component>::reset(std::uint32_t value) {
+	void ComponentCollection<Component>::reserve(std::uint32_t capacity) {
+		components.reserve(capacity);
+		Collection::reserve(capacity);
+	}
+
+	template <typename Component>
+	void ComponentCollection<Component>::shrink_to_fit() {
+		compact();
+		components.shrink_to_fit();
+		Collection::shrink_to_fit();
+
+		if (front) {
+			front->shrink_to_fit();
+		}
+	}
+
+	template <typename Component>
+	Footprint ComponentCollection<Component>::footprint() const {
+		auto footprint = Collection::footprint();
+
+		footprint.dense += components.size() * sizeof(Component);
+		footprint.slack += (components.capacity() - components.size()) * sizeof(Component);
+
+		if (cold) {
+			footprint += cold->footprint();
+		}
+
+		if (front) {
+			footprint += front->footprint();
+		}
+
+		return footprint;
+	}
+
+	/**
+	* @brief Removes the tombstones, preserving the order of the remaining values.
+	*
+	* Components are moved back over the tombstones in a single pass, then the
+	* ones left at the end of the packed array are destroyed.
+	*/
+	template <typename Component>
+	void ComponentCollection<Component>::compact() {
+		if (dead) {
+			auto last = std::uint32_t(0);
+
+			for (std::uint32_t i = 0U, size = this->size(); i < size; ++i) {
+				if (values[i] != Entity::INVALID) {
+					if (i != last) {
+						values[last] = values[i];
+						components[last] = std::move(components[i]);
+						indices[values[last] & Entity::ID_MASK] = last;
+					}
+
+					++last;
+				}
+			}
+
+			values.erase(values.begin() + last, values.end());
+			components.erase(components.begin() + last, components.end());
+			dead = 0U;
+			++changes;
+		}
+	}
+
+	/**
+	* @brief Enables or disables stable removal.
+	*
+	* Disabling it compacts the set, so that there are no tombstones left.
+	*/
+	template <typename Component>
+	void ComponentCollection<Component>::stabilize(bool enabled) {
+		tombstoning = enabled;
+
+		if (!enabled) {
+			compact();
+		}
+	}
+
+	template <typename Component>
+	bool ComponentCollection<Component>::stable() const {
+		return tombstoning;
+	}
+
+	/**
+	* @brief Enables the cold tier, or disables it if the period is zero.
+	*
+	* Disabling the cold tier brings all the frozen components back.
+	*
+	* @param period Number of calls to `freeze` after which components that
+	* haven't been touched are moved to the cold tier.
+	* @param compressed Whether the cold tier compresses its blocks.
+	*/
+	template <typename Component>
+	void ComponentCollection<Component>::tier(std::uint32_t period, bool compressed) {
+		static_assert(std::is_trivially_copyable<Component>::value, "Only trivially copyable components can be frozen");
+
+		thaw();
+		cold = period ? std::make_unique<ColdStorage>(std::uint32_t(sizeof(Component)), period, compressed) : nullptr;
+	}
+
+	/**
+	* @brief Starts a new epoch and moves the stale components to the cold tier.
+	* @return The number of components moved.
+	*/
+	template <typename Component>
+	std::uint32_t ComponentCollection<Component>::freeze() {
+		return cold ? freeze(std::is_trivially_copyable<Component>{}) : 0U;
+	}
+
+	template <typename Component>
+	bool ComponentCollection<Component>::thaw(EntityId value) {
+		if (cold && cold->contains(value)) {
+			typename std::aligned_storage<sizeof(Component), alignof(Component)>::type buffer;
+
+			cold->load(value, &buffer);
+			restore(value, &buffer, std::is_trivially_copyable<Component>{});
+
+			return true;
+		}
+
+		return false;
+	}
+
+	/**
+	* @brief Brings all the frozen components back.
+	*/
+	template <typename Component>
+	void ComponentCollection<Component>::thaw() {
+		if (frozen()) {
+			components.reserve(components.size() + cold->size());
+
+			cold->drain([this](EntityId value, const std::uint8_t* bytes) {
+				restore(value, bytes, std::is_trivially_copyable<Component>{});
+			});
+		}
+	}
+
+	/**
+	* @brief Returns true if the component of a value sits in the cold tier.
+	*/
+	template <typename Component>
+	bool ComponentCollection<Component>::frozen(EntityId value) const {
+		return cold && cold->contains(value);
+	}
+
+	/**
+	* @brief Returns the number of components that sit in the cold tier.
+	*/
+	template <typename Component>
+	std::uint32_t ComponentCollection<Component>::frozen() const {
+		return cold ? cold->size() : 0U;
+	}
+
+	/**
+	* @brief Marks the component of a value as accessed, bringing it back from
+	* the cold tier if needed.
+	*
+	* Sets without a cold tier do nothing.
+	*/
+	template <typename Component>
+	void ComponentCollection<Component>::touch(EntityId value) {
+		if (cold) {
+			thaw(value);
+			cold->touch(value);
+		}
+	}
+
+	/**
+	* @brief Marks all the components as accessed, so that iterated sets aren't
+	* frozen.
+	*
+	* Sets without a cold tier do nothing.
+	*/
+	template <typename Component>
+	void ComponentCollection<Component>::touch() {
+		if (cold) {
+			cold->touch();
+		}
+	}
+
+	/**
+	* @brief Enables or disables the front buffer.
+	*
+	* The front buffer is filled right away, it stays at the same address until
+	* double buffering is disabled.
+	*/
+	template <typename Component>
+	void ComponentCollection<Component>::buffer(bool enabled) {
+		static_assert(std::is_copy_assignable<Component>::value, "Only copy assignable components can be double buffered");
+
+		if (!enabled) {
+			front = nullptr;
+		}
+		else if (!front) {
+			front = std::make_unique<ComponentCollection>();
+			flip();
+		}
+	}
+
+	/**
+	* @brief Mirrors the whole set into the front buffer.
+	*
+	* Values, indices and components are copied over the previous ones, thus
+	* the front buffer doesn't allocate once it has reached its steady size.
+	* Components are copied (not moved), the set is left untouched.
+	*
+	* @warning
+	* Reading the front buffer while flipping it results in undefined behavior.
+	*/
+	template <typename Component>
+	void ComponentCollection<Component>::flip() {
+		if (front) {
+			front->mirror(*this);
+		}
+	}
+
+	/**
+	* @brief Returns the front buffer, a null pointer if the set isn't double
+	* buffered.
+	*/
+	template <typename Component>
+	const ComponentCollection<Component>* ComponentCollection<Component>::buffered() const {
+		return front.get();
+	}
+
+	/**
+	* @brief Turns this set into a copy of another set of the same type.
+	*
+	* Components are copy assigned over the previous ones, the other set is
+	* left untouched. Listeners see the set cleared and all the components
+	* added back. Tombstones come along with stable removal, cold tiers and
+	* front buffers are left as they are (see `clone`).
+	*/
+	template <typename Component>
+	void ComponentCollection<Component>::mirror(const Collection& other) {
+		mirror(static_cast<const ComponentCollection&>(other), std::is_copy_assignable<Component>{});
+	}
+
+	template <typename Component>
+	bool ComponentCollection<Component>::empty() const {
+		return size() == dead && !frozen();
+	}
+
+	template <typename Component>
+	bool ComponentCollection<Component>::reset(EntityId value) {
+		touch(value);
 		return contains(value) ? remove(value) : false;
 	}
 
 	template <typename Component>
-	bool ComponentCollection<Component>::remove(std::uint32_t value) {
-		auto removed = Collection::remove(value);
+	bool ComponentCollection<Component>::remove(EntityId value) {
+		touch(value);
+
+		if (!contains(value)) {
+			return false;
+		}
+
+		for (auto listener : listeners) {
+			listener->removed(value, components[position(value)]);
+		}
+
+		discard(value);
+
+		return true;
+	}
+
+	/**
+	* @brief Removes a value and its component, listeners aren't notified.
+	*/
+	template <typename Component>
+	void ComponentCollection<Component>::discard(EntityId value) {
+		const auto index = position(value);
+
+		// The component stays where it is until the next compaction
+		if (tombstoning) {
+			values[index] = Entity::INVALID;
+			indices[value & Entity::ID_MASK] = 0U;
+			++dead;
+			++changes;
+			return;
+		}
+
+		Collection::remove(value);
+
+		if (index != components.size() - 1U) {
+			components[index] = std::move(components.back());
+		}
+
+		components.pop_back();
+	}
+
+	template <typename Component>
+	void ComponentCollection<Component>::swap(std::uint32_t lhs, std::uint32_t rhs) {
+		std::swap(components[lhs], components[rhs]);
+		Collection::swap(lhs, rhs);
+	}
+
+	template <typename Component>
+	void ComponentCollection<Component>::merge(Collection& other, const std::vector<EntityId>& table) {
+		auto& source = static_cast<ComponentCollection<Component>&>(other);
+		const auto offset = components.size();
+
+		source.thaw();
+		source.compact();
+
+		// Components are moved as a single block, in the same order as their values
+		components.insert(components.end(), std::make_move_iterator(source.components.begin()), std::make_move_iterator(source.components.end()));
+		Collection::merge(other, table);
+
+		for (auto listener : listeners) {
+			for (auto i = offset; i < components.size(); ++i) {
+				listener->added(values[i], components[i]);
+			}
+		}
+	}
+
+	template <typename Component>
+	void ComponentCollection<Component>::transfer(EntityId value, Collection& destination, EntityId id) {
+		touch(value);
+		static_cast<ComponentCollection<Component>&>(destination).emplace(id, std::move(get(value)));
+		remove(value);
+	}
+
+	template <typename Component>
+	std::unique_ptr<Collection> ComponentCollection<Component>::create() const {
+		return std::make_unique<ComponentCollection<Component>>();
+	}
+
+	/**
+	* @brief Creates a copy of the set, cold tier and front buffer included.
+	*
+	* Listeners aren't copied.
+	*/
+	template <typename Component>
+	std::unique_ptr<Collection> ComponentCollection<Component>::clone() const {
+		auto copy = std::make_unique<ComponentCollection<Component>>();
+
+		copy->mirror(*this);
+
+		if (cold) {
+			copy->cold = std::make_unique<ColdStorage>(*cold);
+		}
+
+		if (front) {
+			copy->front = std::make_unique<ComponentCollection>();
+			copy->flip();
+		}
+
+		return copy;
+	}
+
+	template <typename Component>
+	void ComponentCollection<Component>::replicate(EntityId value, Collection& destination, const std::vector<EntityId>& ids) {
+		copy(value, static_cast<ComponentCollection<Component>&>(destination), ids, std::is_copy_constructible<Component>());
+	}
+
+	template <typename Component>
+	void ComponentCollection<Component>::copy(EntityId value, ComponentCollection& destination, const std::vector<EntityId>& ids, std::true_type) {
+		const auto offset = destination.components.size();
 
-		if (removed) {
-			components[indices[value] & ~OCCUPIED] = std::move(components.back());
+		if (frozen(value)) {
+			// Read in place, the set may be shared with forks
+			typename std::aligned_storage<sizeof(Component), alignof(Component)>::type buffer;
+
+			cold->peek(value, &buffer);
+			destination.components.insert(destination.components.end(), ids.size(), reinterpret_cast<const Component&>(buffer));
+		}
+		else {
+			const auto index = position(value);
+
+			// Reserve first: the source component may live in the destination itself
+			destination.components.reserve(offset + ids.size());
+			destination.components.insert(destination.components.end(), ids.size(), components[index]);
+		}
+
+		destination.Collection::append(ids);
+
+		for (auto listener : destination.listeners) {
+			for (auto i = offset; i < destination.components.size(); ++i) {
+				listener->added(destination.values[i], destination.components[i]);
+			}
+		}
+	}
+
+	template <typename Component>
+	void ComponentCollection<Component>::copy(EntityId, ComponentCollection&, const std::vector<EntityId>&, std::false_type) {
+		throw std::runtime_error("Component is not copy constructible");
+	}
+
+	template <typename Component>
+	void ComponentCollection<Component>::restore(EntityId value, const void* bytes, std::true_type) {
+		typename std::aligned_storage<sizeof(Component), alignof(Component)>::type buffer;
+
+		std::memcpy(&buffer, bytes, sizeof(Component));
+		components.push_back(reinterpret_cast<const Component&>(buffer));
+
+		// A value that is hot already keeps its component, the cold copy is older
+		if (!Collection::add(value)) {
 			components.pop_back();
+			return;
+		}
+
+		for (auto listener : listeners) {
+			listener->replaced(value, components.back());
+		}
+	}
+
+	template <typename Component>
+	void ComponentCollection<Component>::restore(EntityId, const void*, std::false_type) {
+		throw std::runtime_error("Component is not trivially copyable");
+	}
+
+	template <typename Component>
+	std::uint32_t ComponentCollection<Component>::freeze(std::true_type) {
+		auto stale = std::vector<EntityId>();
+
+		cold->advance();
+
+		for (auto value : values) {
+			if (value != Entity::INVALID && cold->stale(value)) {
+				stale.push_back(value);
+			}
+		}
+
+		if (!stale.empty()) {
+			auto bytes = std::vector<std::uint8_t>(stale.size() * sizeof(Component));
+
+			for (std::size_t i = 0U; i < stale.size(); ++i) {
+				std::memcpy(bytes.data() + i * sizeof(Component), &components[position(stale[i])], sizeof(Component));
+			}
+
+			cold->store(stale.data(), bytes.data(), std::uint32_t(stale.size()));
+
+			for (auto value : stale) {
+				discard(value);
+			}
 		}
 
-		return removed;
+		return std::uint32_t(stale.size());
+	}
+
+	template <typename Component>
+	std::uint32_t ComponentCollection<Component>::freeze(std::false_type) {
+		throw std::runtime_error("Component is not trivially copyable");
 	}
 
 	template <typename Component>
-	bool ComponentCollection<Component>::add(std::uint32_t value, const Component& component) {
-		return Collection::add(value) ? components.emplace_back(component), true : false;
+	void ComponentCollection<Component>::mirror(const ComponentCollection& source, std::true_type) {
+		for (auto listener : listeners) {
+			listener->cleared();
+		}
+
+		components = source.components;
+		Collection::mirror(source);
+		tombstoning = source.tombstoning; // Tombstones are copied as well
+
+		for (auto listener : listeners) {
+			for (std::uint32_t i = 0U, size = this->size(); i < size; ++i) {
+				if (values[i] != Entity::INVALID) {
+					listener->added(values[i], components[i]);
+				}
+			}
+		}
 	}
 
 	template <typename Component>
-	bool ComponentCollection<Component>::update(std::uint32_t value, const Component& component) {
-		return contains(value) ? components[indices[value] & ~OCCUPIED] = component, true : false; // Execute and return
+	void ComponentCollection<Component>::mirror(const ComponentCollection&, std::false_type) {
+		throw std::runtime_error("Component is not copy assignable");
 	}
 
 	template <typename Component>
-	void ComponentCollection<Component>::accomodate(std::uint32_t value, const Component& component) {
+	bool ComponentCollection<Component>::add(EntityId value, const Component& component) {
+		return contains(value) ? false : (emplace(value, component), true);
+	}
+
+	template <typename Component>
+	bool ComponentCollection<Component>::add(EntityId value, Component&& component) {
+		return contains(value) ? false : (emplace(value, std::move(component)), true);
+	}
+
+	template <typename Component>
+	bool ComponentCollection<Component>::update(EntityId value, const Component& component) {
+		return contains(value) ? replace(value, component), true : false; // Execute and return
+	}
+
+	template <typename Component>
+	bool ComponentCollection<Component>::update(EntityId value, Component&& component) {
+		return contains(value) ? replace(value, std::move(component)), true : false; // Execute and return
+	}
+
+	template <typename Component>
+	void ComponentCollection<Component>::accomodate(EntityId value, const Component& component) {
 		contains(value) ? update(value, component) : add(value, component);
 	}
 
 	template <typename Component>
-	Component& ComponentCollection<Component>::get(std::uint32_t value) {
-		return components[indices[value] & ~OCCUPIED];
+	void ComponentCollection<Component>::accomodate(EntityId value, Component&& component) {
+		contains(value) ? update(value, std::move(component)) : add(value, std::move(component));
+	}
+
+	/**
+	* @brief Constructs a component in place at the end of the packed array.
+	*
+	* The component is built directly into the underlying storage from the given
+	* arguments, thus no temporary is created nor copied around.
+	*
+	* @warning
+	* Attempting to emplace a component for a value that is already contained
+	* throws `std::runtime_error`, the set is left untouched.
+	*
+	* @return A reference to the newly created component.
+	*/
+	template <typename Component>
+	template <typename... Args>
+	Component& ComponentCollection<Component>::emplace(EntityId value, Args&&... args) {
+		touch(value);
+		components.emplace_back(std::forward<Args>(args)...); // Construct first, so a throwing constructor leaves the set untouched
+
+		if (!Collection::add(value)) {
+			components.pop_back();
+			throw std::runtime_error("Component already assigned");
+		}
+
+		for (auto listener : listeners) {
+			listener->added(value, components.back());
+		}
+
+		return components.back();
+	}
+
+	/**
+	* @brief Replaces the component of the given value by move assigning a new one.
+	*
+	* @warning
+	* Attempting to replace a component for a value that isn't contained
+	* throws `std::runtime_error`, the set is left untouched.
+	*
+	* @return A reference to the replaced component.
+	*/
+	template <typename Component>
+	template <typename... Args>
+	Component& ComponentCollection<Component>::replace(EntityId value, Args&&... args) {
+		touch(value);
+
+		if (!contains(value)) {
+			throw std::runtime_error("Component not assigned");
+		}
+
+		auto& component = components[position(value)];
+		component = Component(std::forward<Args>(args)...);
+		++changes;
+
+		for (auto listener : listeners) {
+			listener->replaced(value, component);
+		}
+
+		return component;
+	}
+
+	template <typename Component>
+	Component& ComponentCollection<Component>::get(EntityId value) {
+		return components[position(value)];
+	}
+
+	template <typename Component>
+	const Component& ComponentCollection<Component>::get(EntityId value) const {
+		return components[position(value)];
+	}
+
+	/**
+	* @brief Direct access to the packed array of components.
+	*
+	* Components are in the same order as the values returned by `data`, the
+	* array contains exactly `size` elements.
+	*/
+	template <typename Component>
+	Component* ComponentCollection<Component>::raw() {
+		return components.data();
+	}
+
+	template <typename Component>
+	const Component* ComponentCollection<Component>::raw() const {
+		return components.data();
+	}
+
+	/**
+	* @brief Sorts the components and their values according to the given
+	* comparison function object.
+	*
+	* The set is compacted first. The comparison function object receives two
+	* components and must return true if the first one is less than the second.
+	*/
+	template <typename Component>
+	template <typename Compare>
+	void ComponentCollection<Component>::sort(Compare compare) {
+		compact();
+
+		auto order = std::vector<std::uint32_t>(size());
+
+		for (std::uint32_t i = 0U; i < order.size(); ++i) {
+			order[i] = i;
+		}
+
+		std::stable_sort(order.begin(), order.end(), [this, &compare](std::uint32_t lhs, std::uint32_t rhs) {
+			return compare(static_cast<const Component&>(components[lhs]), static_cast<const Component&>(components[rhs]));
+		});
+
+		auto sorted = std::vector<Component>();
+		auto ids = std::vector<EntityId>();
+
+		sorted.reserve(order.size());
+		ids.reserve(order.size());
+
+		for (auto index : order) {
+			sorted.push_back(std::move(components[index]));
+			ids.push_back(values[index]);
+		}
+
+		components.swap(sorted);
+		values.swap(ids);
+
+		for (std::uint32_t i = 0U; i < values.size(); ++i) {
+			indices[values[i] & Entity::ID_MASK] = i;
+		}
+
+		++changes;
+	}
+
+	/**
+	* @brief Registers a listener to be notified about changes to the components.
+	*
+	* @warning
+	* The lifetime of the listener must overcome the one of the set, or the
+	* listener must be unregistered before it is destroyed.
+	*/
+	template <typename Component>
+	void ComponentCollection<Component>::listen(ComponentListener<Component>* listener) {
+		listeners.push_back(listener);
+	}
+
+	template <typename Component>
+	void ComponentCollection<Component>::unlisten(ComponentListener<Component>* listener) {
+		listeners.erase(std::remove(listeners.begin(), listeners.end(), listener), listeners.end());
+	}
+
+	/**
+	* @brief Reports all the components to a listener as added ones, frozen
+	* components included.
+	*/
+	template <typename Component>
+	void ComponentCollection<Component>::report(ComponentListener<Component>& listener) {
+		for (std::uint32_t i = 0U, size = this->size(); i < size; ++i) {
+			if (values[i] != Entity::INVALID) {
+				listener.added(values[i], components[i]);
+			}
+		}
+
+		if (cold) {
+			cold->each([&listener](EntityId value, const std::uint8_t* bytes) {
+				typename std::aligned_storage<sizeof(Component), alignof(Component)>::type buffer;
+
+				std::memcpy(&buffer, bytes, sizeof(Component));
+				listener.added(value, reinterpret_cast<const Component&>(buffer));
+			});
+		}
 	}
 }
 
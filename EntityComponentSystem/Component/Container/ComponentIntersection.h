@@ -17,6 +17,8 @@ namespace cs
 		const ComponentIntersectionIterator begin() const;
 		const ComponentIntersectionIterator end() const;
 
+		const cs::Collection* candidates() const;
+
 	private:
 		const cs::Collection* smallest;
 		std::vector<const cs::Collection*> others;
@@ -46,6 +46,14 @@ namespace cs
 	const ComponentIntersectionIterator ComponentIntersection<Components...>::end() const {
 		return ComponentIntersectionIterator(others, smallest->end(), smallest->end());
 	}
+
+	/**
+	* @brief Returns the set that drives the iteration, the smallest one.
+	*/
+	template <typename... Components>
+	const cs::Collection* ComponentIntersection<Components...>::candidates() const {
+		return smallest;
+	}
 }
 
 #endif
\ No newline at end of file
@@ -1,13 +1,22 @@
 #ifndef COMPONENT_CONTAINER_COMPONENT_INTERSECTION_ITERATOR_H
 #define COMPONENT_CONTAINER_COMPONENT_INTERSECTION_ITERATOR_H
 
+#include <cstddef>
+#include <iterator>
 #include "ComponentCollection.h"
 
 namespace cs
 {
-	class ComponentIntersectionIterator : public std::iterator<std::input_iterator_tag, std::uint32_t>
+	class ComponentIntersectionIterator
 	{
 	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = EntityId;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const EntityId*;
+		using reference = const EntityId&;
+
+		ComponentIntersectionIterator() = default;
 		ComponentIntersectionIterator(std::vector<const cs::Collection*> others, cs::Collection::IteratorConst begin, cs::Collection::IteratorConst end);
 
 		ComponentIntersectionIterator& operator++(); // Prefix (++it)
@@ -16,15 +25,15 @@ namespace cs
 		bool operator==(const ComponentIntersectionIterator& other) const;
 		bool operator!=(const ComponentIntersectionIterator& other) const;
 
-		std::uint32_t operator*() const;
+		reference operator*() const;
 
 	private:
 		inline bool intersects() const;
 
 	private:
+		std::vector<const cs::Collection*> others;
 		cs::Collection::IteratorConst begin;
 		cs::Collection::IteratorConst end;
-		const std::vector<const cs::Collection*> others;
 	};
 }
 
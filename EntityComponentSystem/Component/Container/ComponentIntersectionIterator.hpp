@@ -29,7 +29,7 @@ namespace cs
 		return other.begin != begin;
 	}
 
-	std::uint32_t ComponentIntersectionIterator::operator*() const {
+	ComponentIntersectionIterator::reference ComponentIntersectionIterator::operator*() const {
 		return *begin;
 	}
 
@@ -0,0 +1,36 @@
+#ifndef COMPONENT_CONTAINER_COMPONENT_LISTENER_H
+#define COMPONENT_CONTAINER_COMPONENT_LISTENER_H
+
+#include <cstdint>
+#include "../../Entity/EntityTraits.h"
+
+namespace cs
+{
+	/**
+	* @brief Observer of a set of components.
+	*
+	* Listeners are notified by a ComponentCollection whenever a component is
+	* added, replaced or removed, thus they can be used to keep auxiliary data
+	* structures (indices, caches and so on) in sync with the components.
+	*
+	* @note
+	* Components modified in place through a reference (as an example, the one
+	* returned by `EntityManager::component`) don't trigger any notification.
+	* Use `replace` or `accomodate` when listeners must be aware of the change.
+	*
+	* @tparam Component Type of component observed.
+	*/
+	template <typename Component>
+	class ComponentListener
+	{
+	public:
+		virtual ~ComponentListener() = default;
+
+		virtual void added(EntityId, const Component&) {}
+		virtual void replaced(EntityId, const Component&) {}
+		virtual void removed(EntityId, const Component&) {}
+		virtual void cleared() {}
+	};
+}
+
+#endif
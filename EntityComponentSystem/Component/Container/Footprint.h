@@ -0,0 +1,39 @@
+#ifndef COMPONENT_CONTAINER_FOOTPRINT_H
+#define COMPONENT_CONTAINER_FOOTPRINT_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace cs
+{
+	/**
+	* @brief Memory statistics of a set or a manager, in bytes.
+	*
+	* Only the memory owned directly by the containers is accounted. Resources
+	* that components allocate on their own (as an example, the buffer of a
+	* string) aren't part of it.
+	*/
+	struct Footprint
+	{
+		std::size_t dense = 0U; // Packed arrays, elements in use only
+		std::size_t sparse = 0U; // Sparse arrays, whole capacity
+		std::size_t slack = 0U; // Packed arrays, capacity not in use
+		std::size_t cold = 0U; // Cold tiers, blocks as stored (compressed or not)
+		std::uint32_t available = 0U; // Length of the free list of the entities
+
+		std::size_t total() const {
+			return dense + sparse + slack + cold;
+		}
+
+		Footprint& operator+=(const Footprint& other) {
+			dense += other.dense;
+			sparse += other.sparse;
+			slack += other.slack;
+			cold += other.cold;
+			available += other.available;
+			return *this;
+		}
+	};
+}
+
+#endif
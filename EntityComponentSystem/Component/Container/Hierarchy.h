@@ -0,0 +1,69 @@
+#ifndef COMPONENT_CONTAINER_HIERARCHY_H
+#define COMPONENT_CONTAINER_HIERARCHY_H
+
+#include "ComponentCollection.h"
+#include "../../Entity/Entity.h"
+
+namespace cs
+{
+	/**
+	* @brief Sparse set of entities arranged as a forest.
+	*
+	* Parent/child relationships are stored alongside the packed array, which is
+	* always kept in depth-first order: every entity is immediately followed by its
+	* whole subtree. Therefore a plain iteration of the set visits parents before
+	* their children and each subtree is a contiguous range of the packed array.
+	*
+	* @note
+	* Reparenting an entity moves its subtree as a single block, so the cost is
+	* proportional to the distance the block travels rather than to the size of
+	* the whole set. Removing an entity hands its children over to its parent
+	* and leaves a tombstone in its place, see `compact`.
+	*/
+	class Hierarchy final : public Collection
+	{
+	public:
+		Hierarchy() = default;
+		Hierarchy(const Hierarchy&) = delete;
+		Hierarchy(Hierarchy&&) = default;
+
+		void clear() override;
+		void reserve(std::uint32_t capacity) override;
+		void shrink_to_fit() override;
+		Footprint footprint() const override;
+		void compact() override;
+		bool add(EntityId value) override;
+		bool remove(EntityId value) override;
+		void merge(Collection& other, const std::vector<EntityId>& table) override;
+		std::unique_ptr<Collection> create() const override;
+		void mirror(const Collection& other) override;
+
+		void attach(EntityId child, EntityId parent);
+		void detach(EntityId child);
+
+		EntityId parent(EntityId value) const;
+		std::uint32_t depth(EntityId value) const;
+		std::uint32_t extent(EntityId value) const;
+
+		IteratorConst begin(EntityId value) const;
+		IteratorConst end(EntityId value) const;
+
+		using Collection::begin;
+		using Collection::end;
+
+		template <typename Function>
+		void each(Function function) const;
+
+		template <typename Function>
+		void children(EntityId value, Function function) const;
+
+	private:
+		void rotate(std::uint32_t first, std::uint32_t middle, std::uint32_t last);
+
+	private:
+		std::vector<EntityId> parents; // Parent of each value, aligned to the packed array
+		std::vector<std::uint32_t> extents; // Size of the subtree rooted at each value, aligned to the packed array
+	};
+}
+
+#endif
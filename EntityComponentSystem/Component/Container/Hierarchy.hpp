@@ -0,0 +1,337 @@
+#ifndef COMPONENT_CONTAINER_HIERARCHY_IMPL
+#define COMPONENT_CONTAINER_HIERARCHY_IMPL
+
+#include <algorithm>
+#include "Hierarchy.h"
+#include "ComponentCollection.hpp"
+
+namespace cs
+{
+	void Hierarchy::clear() {
+		parents.clear();
+		extents.clear();
+		Collection::clear();
+	}
+
+	void Hierarchy::reserve(std::uint32_t capacity) {
+		parents.reserve(capacity);
+		extents.reserve(capacity);
+		Collection::reserve(capacity);
+	}
+
+	void Hierarchy::shrink_to_fit() {
+		compact();
+		parents.shrink_to_fit();
+		extents.shrink_to_fit();
+		Collection::shrink_to_fit();
+	}
+
+	Footprint Hierarchy::footprint() const {
+		auto footprint = Collection::footprint();
+
+		footprint.dense += parents.size() * sizeof(EntityId) + extents.size() * sizeof(std::uint32_t);
+		footprint.slack += (parents.capacity() - parents.size()) * sizeof(EntityId) + (extents.capacity() - extents.size()) * sizeof(std::uint32_t);
+
+		return footprint;
+	}
+
+	/**
+	* @brief Sweeps the tombstones away in a single pass.
+	*
+	* The order of the remaining values is preserved, extents are recomputed
+	* bottom-up from the parents.
+	*/
+	void Hierarchy::compact() {
+		if (dead) {
+			auto last = std::uint32_t(0);
+
+			for (std::uint32_t i = 0U, size = this->size(); i < size; ++i) {
+				if (values[i] != Entity::INVALID) {
+					values[last] = values[i];
+					parents[last] = parents[i];
+					indices[values[last] & Entity::ID_MASK] = last;
+					++last;
+				}
+			}
+
+			values.erase(values.begin() + last, values.end());
+			parents.erase(parents.begin() + last, parents.end());
+			extents.assign(last, 1U);
+
+			// Descendants follow their ancestors, thus a backward pass sees every subtree complete
+			for (auto i = last; i-- > 0U;) {
+				if (parents[i] != Entity::INVALID) {
+					extents[position(parents[i])] += extents[i];
+				}
+			}
+
+			dead = 0U;
+			++changes;
+		}
+	}
+
+	/**
+	* @brief Adds a value to the set as a new root.
+	* @return True if the value wasn't part of the set, false otherwise.
+	*/
+	bool Hierarchy::add(EntityId value) {
+		auto added = Collection::add(value);
+
+		if (added) {
+			parents.push_back(Entity::INVALID);
+			extents.push_back(1U);
+		}
+
+		return added;
+	}
+
+	/**
+	* @brief Removes a value from the set.
+	*
+	* Children of the removed value are attached to its parent (or become roots).
+	* The relative order of all the other values is preserved.<br/>
+	* The value leaves a tombstone (`Entity::INVALID`) behind, a leaf that still
+	* counts towards the extents of its ancestors. Thus the cost is proportional
+	* to the number of direct children only. Tombstones are swept away by
+	* `compact`, or as soon as they fill half of the packed array.
+	*
+	* @return True if the value was part of the set, false otherwise.
+	*/
+	bool Hierarchy::remove(EntityId value) {
+		auto exists = contains(value);
+
+		if (exists) {
+			const auto index = position(value);
+			const auto parent = parents[index];
+			const auto last = index + extents[index];
+
+			// Direct children are handed over to the parent of the removed value
+			for (auto child = index + 1U; child < last; child += extents[child]) {
+				parents[child] = parent;
+			}
+
+			values[index] = Entity::INVALID;
+			extents[index] = 1U;
+			indices[value & Entity::ID_MASK] = 0U;
+			++dead;
+			++changes;
+
+			if (2U * dead > size()) {
+				compact();
+			}
+		}
+
+		return exists;
+	}
+
+	/**
+	* @brief Appends all the values of another hierarchy, translating them on the way.
+	*
+	* The other hierarchy is packed in depth-first order as well, thus appending it
+	* as a whole keeps the order valid: its roots simply become roots of this set.
+	*/
+	void Hierarchy::merge(Collection& other, const std::vector<EntityId>& table) {
+		auto& source = static_cast<Hierarchy&>(other);
+
+		source.compact();
+		parents.reserve(parents.size() + source.parents.size());
+
+		for (auto parent : source.parents) {
+			parents.push_back(parent == Entity::INVALID ? parent : table[parent & Entity::ID_MASK]);
+		}
+
+		extents.insert(extents.end(), source.extents.begin(), source.extents.end());
+		Collection::merge(other, table);
+	}
+
+	std::unique_ptr<Collection> Hierarchy::create() const {
+		return std::make_unique<Hierarchy>();
+	}
+
+	void Hierarchy::mirror(const Collection& other) {
+		auto& source = static_cast<const Hierarchy&>(other);
+
+		parents = source.parents;
+		extents = source.extents;
+		Collection::mirror(other);
+	}
+
+	/**
+	* @brief Makes a value child of another one.
+	*
+	* Values that aren't part of the set yet are added as roots first. The whole
+	* subtree of the child is then moved right after the last descendant of the
+	* parent, so that the packed array stays in depth-first order.
+	*
+	* @warning
+	* Attempting to attach a value to one of its own descendants (or to itself)
+	* results in undefined behavior.<br/>
+	* An assertion will abort the execution at runtime in debug mode in that case.
+	*
+	* @param child Value to reparent.
+	* @param parent New parent of the value, `Entity::INVALID` to make it a root.
+	*/
+	void Hierarchy::attach(EntityId child, EntityId parent) {
+		add(child);
+
+		if (parent != Entity::INVALID) {
+			add(parent);
+		}
+
+		const auto first = position(child);
+		const auto count = extents[first];
+
+		if (parents[first] == parent) {
+			return;
+		}
+
+		assert(parent == Entity::INVALID || position(parent) < first || position(parent) >= first + count);
+
+		const auto destination = (parent == Entity::INVALID) ? size() : position(parent) + extents[position(parent)];
+
+		for (auto ancestor = parents[first]; ancestor != Entity::INVALID; ancestor = parents[position(ancestor)]) {
+			extents[position(ancestor)] -= count;
+		}
+
+		auto offset = first;
+
+		// Move the subtree as a single block, only the values in between are shifted
+		if (destination > first + count) {
+			rotate(first, first + count, destination);
+			offset = destination - count;
+		}
+		else if (destination < first) {
+			rotate(destination, first, first + count);
+			offset = destination;
+		}
+
+		parents[offset] = parent;
+
+		for (auto ancestor = parent; ancestor != Entity::INVALID; ancestor = parents[position(ancestor)]) {
+			extents[position(ancestor)] += count;
+		}
+
+		++changes;
+	}
+
+	/**
+	* @brief Detaches a value from its parent, making it a root.
+	*/
+	void Hierarchy::detach(EntityId child) {
+		if (contains(child)) {
+			attach(child, Entity::INVALID);
+		}
+	}
+
+	/**
+	* @brief Returns the parent of a value, `Entity::INVALID` for roots and values
+	* that aren't part of the set.
+	*/
+	EntityId Hierarchy::parent(EntityId value) const {
+		return contains(value) ? parents[position(value)] : Entity::INVALID;
+	}
+
+	/**
+	* @brief Returns the number of ancestors of a value.
+	*/
+	std::uint32_t Hierarchy::depth(EntityId value) const {
+		auto depth = std::uint32_t(0);
+
+		for (auto ancestor = parent(value); ancestor != Entity::INVALID; ancestor = parents[position(ancestor)]) {
+			++depth;
+		}
+
+		return depth;
+	}
+
+	/**
+	* @brief Returns the number of values in the subtree rooted at a value,
+	* the value itself and the tombstones within the subtree included.
+	*/
+	std::uint32_t Hierarchy::extent(EntityId value) const {
+		return contains(value) ? extents[position(value)] : std::uint32_t(0);
+	}
+
+	/**
+	* @brief Returns an iterator to the beginning of the subtree rooted at a value.
+	*
+	* The range can contain tombstones (`Entity::INVALID`), see `compact`.
+	*
+	* @warning
+	* Attempting to use a value that isn't part of the set results in undefined
+	* behavior.
+	*/
+	Collection::IteratorConst Hierarchy::begin(EntityId value) const {
+		return values.cbegin() + position(value);
+	}
+
+	/**
+	* @brief Returns an iterator to the end of the subtree rooted at a value.
+	*
+	* @warning
+	* Attempting to use a value that isn't part of the set results in undefined
+	* behavior.
+	*/
+	Collection::IteratorConst Hierarchy::end(EntityId value) const {
+		const auto index = position(value);
+		return values.cbegin() + index + extents[index];
+	}
+
+	/**
+	* @brief Iterates the values in depth-first order.
+	*
+	* The function object is invoked for each value with the value itself and its
+	* parent. Parents are always visited before their children, tombstones are
+	* skipped.<br/>
+	* The signature of the function should be equivalent to the following:
+	*
+	* @code{.cpp}
+	* void(EntityId, EntityId);
+	* @endcode
+	*/
+	template <typename Function>
+	void Hierarchy::each(Function function) const {
+		for (std::uint32_t i = 0U, last = size(); i < last; ++i) {
+			if (values[i] != Entity::INVALID) {
+				function(values[i], parents[i]);
+			}
+		}
+	}
+
+	/**
+	* @brief Iterates the direct children of a value, in order.
+	*
+	* The signature of the function should be equivalent to the following:
+	*
+	* @code{.cpp}
+	* void(EntityId);
+	* @endcode
+	*/
+	template <typename Function>
+	void Hierarchy::children(EntityId value, Function function) const {
+		if (contains(value)) {
+			const auto index = position(value);
+			const auto last = index + extents[index];
+
+			for (auto child = index + 1U; child < last; child += extents[child]) {
+				if (values[child] != Entity::INVALID) {
+					function(values[child]);
+				}
+			}
+		}
+	}
+
+	void Hierarchy::rotate(std::uint32_t first, std::uint32_t middle, std::uint32_t last) {
+		std::rotate(values.begin() + first, values.begin() + middle, values.begin() + last);
+		std::rotate(parents.begin() + first, parents.begin() + middle, parents.begin() + last);
+		std::rotate(extents.begin() + first, extents.begin() + middle, extents.begin() + last);
+
+		for (auto i = first; i < last; ++i) {
+			if (values[i] != Entity::INVALID) {
+				indices[values[i] & Entity::ID_MASK] = i;
+			}
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,71 @@
+#ifndef COMPONENT_CONTAINER_RUNTIME_COLLECTION_H
+#define COMPONENT_CONTAINER_RUNTIME_COLLECTION_H
+
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include "ComponentCollection.h"
+#include "../../Type/ComponentType.h"
+
+namespace cs
+{
+	/**
+	* @brief Sparse set of components whose type is known at runtime only.
+	*
+	* Components are stored in a single packed column of raw memory, aligned to
+	* the type and in the same order as the values, and are handled through the
+	* hooks of the type (see ComponentType). As for ComponentCollection, the
+	* column can be walked directly along with `data`, see `raw` and `stride`.
+	*
+	* @note
+	* Listeners, tombstones, cold tiers and front buffers are for native sets
+	* only.
+	*/
+	class RuntimeCollection final : public Collection
+	{
+	public:
+		explicit RuntimeCollection(const ComponentType& type);
+		RuntimeCollection(const RuntimeCollection&) = delete;
+		~RuntimeCollection();
+
+		RuntimeCollection& operator=(const RuntimeCollection&) = delete;
+
+		void clear() override;
+		void reserve(std::uint32_t capacity) override;
+		void shrink_to_fit() override;
+		Footprint footprint() const override;
+		bool remove(EntityId value) override;
+		void swap(std::uint32_t lhs, std::uint32_t rhs) override;
+		void merge(Collection& other, const std::vector<EntityId>& table) override;
+		void transfer(EntityId value, Collection& destination, EntityId id) override;
+		std::unique_ptr<Collection> create() const override;
+		void replicate(EntityId value, Collection& destination, const std::vector<EntityId>& ids) override;
+		void mirror(const Collection& other) override;
+
+		void* emplace(EntityId value, const void* component = nullptr);
+		void* get(EntityId value);
+		const void* get(EntityId value) const;
+		std::uint8_t* raw();
+		const std::uint8_t* raw() const;
+		std::size_t stride() const;
+		const ComponentType& type() const;
+
+	private:
+		std::uint8_t* at(std::uint32_t index) const;
+		void* push(EntityId value);
+		void relocate(std::uint32_t capacity);
+		void construct(void* destination, const void* source) const;
+		void move(void* destination, void* source) const;
+		void destroy(void* component) const;
+
+	private:
+		ComponentType descriptor;
+		std::size_t step; // Size rounded up to the alignment
+		std::uint32_t capacity = 0U;
+		std::unique_ptr<std::uint8_t[]> memory;
+		std::uint8_t* column = nullptr; // Aligned within the memory, a spare slot follows the last one
+	};
+}
+
+#endif
@@ -0,0 +1,269 @@
+#ifndef COMPONENT_CONTAINER_RUNTIME_COLLECTION_IMPL
+#define COMPONENT_CONTAINER_RUNTIME_COLLECTION_IMPL
+
+#include <cstring>
+#include <algorithm>
+#include "RuntimeCollection.h"
+#include "ComponentCollection.hpp"
+
+namespace cs
+{
+	RuntimeCollection::RuntimeCollection(const ComponentType& type)
+		: descriptor(type)
+		, step((type.size + type.alignment - 1U) / type.alignment * type.alignment)
+	{
+		relocate(0U);
+	}
+
+	RuntimeCollection::~RuntimeCollection() {
+		clear();
+	}
+
+	void RuntimeCollection::clear() {
+		for (std::uint32_t i = 0U; i < size(); ++i) {
+			destroy(at(i));
+		}
+
+		Collection::clear();
+	}
+
+	void RuntimeCollection::reserve(std::uint32_t capacity) {
+		if (capacity > this->capacity) {
+			relocate(capacity);
+		}
+
+		Collection::reserve(capacity);
+	}
+
+	void RuntimeCollection::shrink_to_fit() {
+		if (capacity > size()) {
+			relocate(size());
+		}
+
+		Collection::shrink_to_fit();
+	}
+
+	Footprint RuntimeCollection::footprint() const {
+		auto footprint = Collection::footprint();
+
+		footprint.dense += size() * step;
+		footprint.slack += (capacity - size() + 1U) * step + descriptor.alignment;
+
+		return footprint;
+	}
+
+	bool RuntimeCollection::remove(EntityId value) {
+		if (!contains(value)) {
+			return false;
+		}
+
+		const auto index = position(value);
+		const auto last = size() - 1U;
+
+		destroy(at(index));
+
+		if (index != last) {
+			move(at(index), at(last));
+			destroy(at(last));
+		}
+
+		Collection::remove(value);
+
+		return true;
+	}
+
+	void RuntimeCollection::swap(std::uint32_t lhs, std::uint32_t rhs) {
+		const auto spare = at(capacity);
+
+		if (lhs == rhs) {
+			return;
+		}
+
+		move(spare, at(lhs));
+		destroy(at(lhs));
+		move(at(lhs), at(rhs));
+		destroy(at(rhs));
+		move(at(rhs), spare);
+		destroy(spare);
+
+		Collection::swap(lhs, rhs);
+	}
+
+	/**
+	* @brief Moves all the components of another set of the same type, in order.
+	*/
+	void RuntimeCollection::merge(Collection& other, const std::vector<EntityId>& table) {
+		auto& source = static_cast<RuntimeCollection&>(other);
+		const auto offset = size();
+
+		if (offset + source.size() > capacity) {
+			relocate(std::max(offset + source.size(), capacity * 2U));
+		}
+
+		for (std::uint32_t i = 0U; i < source.size(); ++i) {
+			move(at(offset + i), source.at(i));
+		}
+
+		// Moved-from components are destroyed along with the other set
+		Collection::merge(other, table);
+	}
+
+	void RuntimeCollection::transfer(EntityId value, Collection& destination, EntityId id) {
+		move(static_cast<RuntimeCollection&>(destination).push(id), get(value));
+		remove(value);
+	}
+
+	std::unique_ptr<Collection> RuntimeCollection::create() const {
+		return std::make_unique<RuntimeCollection>(descriptor);
+	}
+
+	void RuntimeCollection::replicate(EntityId value, Collection& destination, const std::vector<EntityId>& ids) {
+		auto& target = static_cast<RuntimeCollection&>(destination);
+		const auto offset = target.size();
+		const auto index = position(value);
+
+		if (offset + ids.size() > target.capacity) {
+			target.relocate(std::max(std::uint32_t(offset + ids.size()), target.capacity * 2U));
+		}
+
+		// Grow first: the source component may live in the destination itself
+		for (std::uint32_t i = 0U; i < ids.size(); ++i) {
+			construct(target.at(offset + i), at(index));
+		}
+
+		target.Collection::append(ids);
+	}
+
+	/**
+	* @brief Turns this set into a copy of another set of the same type.
+	*
+	* Components are destroyed and copy constructed again, the column is only
+	* reallocated if it's too small. Trivial types are copied as a block.
+	*/
+	void RuntimeCollection::mirror(const Collection& other) {
+		auto& source = static_cast<const RuntimeCollection&>(other);
+
+		for (std::uint32_t i = 0U; i < size(); ++i) {
+			destroy(at(i));
+		}
+
+		// Nothing is left to move if the column must grow
+		values.clear();
+
+		if (source.size() > capacity) {
+			relocate(source.size());
+		}
+
+		if (descriptor.copy) {
+			for (std::uint32_t i = 0U; i < source.size(); ++i) {
+				construct(at(i), source.at(i));
+			}
+		}
+		else if (source.size()) {
+			std::memcpy(column, source.column, std::size_t(source.size()) * step);
+		}
+
+		Collection::mirror(other);
+	}
+
+	/**
+	* @brief Constructs a component at the end of the column.
+	*
+	* @warning
+	* Attempting to emplace a component for a value that is already contained
+	* throws `std::runtime_error`, the set is left untouched.
+	*
+	* @param component Component to copy, a default constructed one is used if null.
+	* @return A pointer to the newly created component.
+	*/
+	void* RuntimeCollection::emplace(EntityId value, const void* component) {
+		const auto destination = push(value);
+		construct(destination, component);
+		return destination;
+	}
+
+	void* RuntimeCollection::get(EntityId value) {
+		return at(position(value));
+	}
+
+	const void* RuntimeCollection::get(EntityId value) const {
+		return at(position(value));
+	}
+
+	/**
+	* @brief Direct access to the column of components.
+	*
+	* Components are in the same order as the values returned by `data`, each
+	* one `stride` bytes after the previous one.
+	*/
+	std::uint8_t* RuntimeCollection::raw() {
+		return column;
+	}
+
+	const std::uint8_t* RuntimeCollection::raw() const {
+		return column;
+	}
+
+	std::size_t RuntimeCollection::stride() const {
+		return step;
+	}
+
+	const ComponentType& RuntimeCollection::type() const {
+		return descriptor;
+	}
+
+	std::uint8_t* RuntimeCollection::at(std::uint32_t index) const {
+		return column + std::size_t(index) * step;
+	}
+
+	void* RuntimeCollection::push(EntityId value) {
+		if (contains(value)) {
+			throw std::runtime_error("Component already assigned");
+		}
+
+		if (size() == capacity) {
+			relocate(std::max(8U, capacity * 2U));
+		}
+
+		const auto destination = at(size());
+		Collection::add(value);
+
+		return destination;
+	}
+
+	void RuntimeCollection::relocate(std::uint32_t capacity) {
+		auto memory = std::unique_ptr<std::uint8_t[]>(new std::uint8_t[(std::size_t(capacity) + 1U) * step + descriptor.alignment]);
+		const auto address = reinterpret_cast<std::uintptr_t>(memory.get());
+		const auto column = memory.get() + (descriptor.alignment - address % descriptor.alignment) % descriptor.alignment;
+
+		for (std::uint32_t i = 0U; i < size(); ++i) {
+			move(column + std::size_t(i) * step, at(i));
+			destroy(at(i));
+		}
+
+		this->memory = std::move(memory);
+		this->column = column;
+		this->capacity = capacity;
+	}
+
+	void RuntimeCollection::construct(void* destination, const void* source) const {
+		if (source) {
+			descriptor.copy ? descriptor.copy(destination, source) : void(std::memcpy(destination, source, descriptor.size));
+		}
+		else {
+			descriptor.construct ? descriptor.construct(destination) : void(std::memset(destination, 0, descriptor.size));
+		}
+	}
+
+	void RuntimeCollection::move(void* destination, void* source) const {
+		descriptor.move ? descriptor.move(destination, source) : void(std::memcpy(destination, source, descriptor.size));
+	}
+
+	void RuntimeCollection::destroy(void* component) const {
+		if (descriptor.destroy) {
+			descriptor.destroy(component);
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,157 @@
+#ifndef COMPONENT_CONTAINER_SHARED_COLLECTION_H
+#define COMPONENT_CONTAINER_SHARED_COLLECTION_H
+
+#include <vector>
+#include <memory>
+#include <utility>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <unordered_map>
+#include "ComponentCollection.h"
+
+namespace cs
+{
+	/**
+	* @brief Handle to a value shared by many entities.
+	*
+	* Use `Shared<Type>` as the type of a component to have equal values stored
+	* only once per manager. Entities hold a pointer sized handle to the interned
+	* value, which is immutable: replace the component to change it.<br/>
+	* Handles can't be assigned, since that would bypass the reference counts.
+	* Copies are valid as long as an entity holds the same value.
+	*
+	* @note
+	* Types of shared values must be copy constructible, equality comparable and
+	* hashable through the given hash function object.
+	*
+	* @tparam Type Type of the shared value.
+	* @tparam Hash Hash function object for the type of the shared value.
+	*/
+	template <typename Type, typename Hash = std::hash<Type>>
+	class Shared final
+	{
+	public:
+		Shared() = default;
+		Shared(const Shared&) = default;
+
+		const Type& operator*() const {
+			return entry->first;
+		}
+
+		const Type* operator->() const {
+			return &entry->first;
+		}
+
+		bool operator==(const Shared& other) const {
+			return entry == other.entry;
+		}
+
+		bool operator!=(const Shared& other) const {
+			return entry != other.entry;
+		}
+
+		/**
+		* @brief Returns the number of entities that share the value.
+		*/
+		std::uint32_t references() const {
+			return entry->second;
+		}
+
+	private:
+		template <typename>
+		friend class ComponentCollection;
+
+		using Entry = std::pair<const Type, std::uint32_t>;
+
+		explicit Shared(Entry* entry)
+			: entry(entry)
+		{}
+
+		Shared& operator=(const Shared&) = default;
+
+	private:
+		Entry* entry = nullptr;
+	};
+
+	/**
+	* @brief Sparse set specialization for shared components.
+	*
+	* Unique values are interned in a hash table along with the number of
+	* entities that refer to them, the packed array stores handles only. Values
+	* are dropped as soon as no entity refers to them anymore.
+	*
+	* @tparam Type Type of the shared value.
+	* @tparam Hash Hash function object for the type of the shared value.
+	*/
+	template <typename Type, typename Hash>
+	class ComponentCollection<Shared<Type, Hash>> final : public Collection
+	{
+	public:
+		using Component = Shared<Type, Hash>;
+
+		ComponentCollection() = default;
+		ComponentCollection(const ComponentCollection&) = delete;
+		ComponentCollection(ComponentCollection&&) = default;
+
+		void clear() override;
+		void resize(std::uint32_t capacity) override;
+		void reserve(std::uint32_t capacity) override;
+		void shrink_to_fit() override;
+		Footprint footprint() const override;
+		bool reset(EntityId value);
+		bool remove(EntityId value) override;
+		void swap(std::uint32_t lhs, std::uint32_t rhs) override;
+		void merge(Collection& other, const std::vector<EntityId>& table) override;
+		void transfer(EntityId value, Collection& destination, EntityId id) override;
+		std::unique_ptr<Collection> create() const override;
+		void replicate(EntityId value, Collection& destination, const std::vector<EntityId>& ids) override;
+		void mirror(const Collection& other) override;
+		bool add(EntityId value, const Component& component);
+		bool update(EntityId value, const Component& component);
+		void accomodate(EntityId value, const Component& component);
+
+		Component& emplace(EntityId value, const Component& component);
+
+		template <typename... Args, typename = std::enable_if_t<std::is_constructible<Type, Args...>::value>>
+		Component& emplace(EntityId value, Args&&... args);
+
+		Component& replace(EntityId value, const Component& component);
+
+		template <typename... Args, typename = std::enable_if_t<std::is_constructible<Type, Args...>::value>>
+		Component& replace(EntityId value, Args&&... args);
+
+		Component& get(EntityId value);
+		Component* raw();
+		const Component* raw() const;
+
+		std::uint32_t distinct() const;
+		bool frozen(EntityId value) const override;
+		std::uint32_t frozen() const;
+		void thaw() override;
+		void touch(EntityId value);
+		void touch();
+
+		template <typename Function>
+		void group(Function function);
+
+		void listen(ComponentListener<Component>* listener);
+		void unlisten(ComponentListener<Component>* listener);
+		void report(ComponentListener<Component>& listener);
+
+	private:
+		template <typename... Args>
+		Component intern(Args&&... args);
+		void release(const Component& component);
+		Component& insert(EntityId value, Component component);
+		Component& assign(EntityId value, Component component);
+		void arrange();
+
+	private:
+		std::unordered_map<Type, std::uint32_t, Hash> interned; // Unique values and their reference counts
+		std::vector<Component> components; // Handles, aligned to the packed array
+		std::vector<ComponentListener<Component>*> listeners;
+	};
+}
+
+#endif
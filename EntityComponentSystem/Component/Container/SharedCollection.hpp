@@ -0,0 +1,432 @@
+#ifndef COMPONENT_CONTAINER_SHARED_COLLECTION_IMPL
+#define COMPONENT_CONTAINER_SHARED_COLLECTION_IMPL
+
+#include <algorithm>
+#include "SharedCollection.h"
+#include "ComponentCollection.hpp"
+
+namespace cs
+{
+	template <typename Type, typename Hash>
+	void ComponentCollection<Shared<Type, Hash>>::clear() {
+		components.clear();
+		interned.clear();
+		Collection::clear();
+
+		for (auto listener : listeners) {
+			listener->cleared();
+		}
+	}
+
+	template <typename Type, typename Hash>
+	void ComponentCollection<Shared<Type, Hash>>::resize(std::uint32_t capacity) {
+		components.resize(capacity);
+		Collection::resize(capacity);
+	}
+
+	template <typename Type, typename Hash>
+	void ComponentCollection<Shared<Type, Hash>>::reserve(std::uint32_t capacity) {
+		components.reserve(capacity);
+		Collection::reserve(capacity);
+	}
+
+	template <typename Type, typename Hash>
+	void ComponentCollection<Shared<Type, Hash>>::shrink_to_fit() {
+		components.shrink_to_fit();
+		interned.rehash(0U);
+		Collection::shrink_to_fit();
+	}
+
+	/**
+	* @brief Returns the memory statistics of the set.
+	*
+	* Nodes of the hash table are accounted as dense memory, an estimate since
+	* their layout depends on the implementation of the standard library.
+	*/
+	template <typename Type, typename Hash>
+	Footprint ComponentCollection<Shared<Type, Hash>>::footprint() const {
+		auto footprint = Collection::footprint();
+
+		footprint.dense += components.size() * sizeof(Component);
+		footprint.dense += interned.size() * (sizeof(typename decltype(interned)::value_type) + sizeof(void*) + sizeof(std::size_t));
+		footprint.sparse += interned.bucket_count() * sizeof(void*);
+		footprint.slack += (components.capacity() - components.size()) * sizeof(Component);
+
+		return footprint;
+	}
+
+	template <typename Type, typename Hash>
+	bool ComponentCollection<Shared<Type, Hash>>::reset(EntityId value) {
+		return contains(value) ? remove(value) : false;
+	}
+
+	template <typename Type, typename Hash>
+	bool ComponentCollection<Shared<Type, Hash>>::remove(EntityId value) {
+		if (!contains(value)) {
+			return false;
+		}
+
+		const auto index = position(value);
+
+		for (auto listener : listeners) {
+			listener->removed(value, components[index]);
+		}
+
+		release(components[index]);
+		Collection::remove(value);
+		components[index] = components.back();
+		components.pop_back();
+
+		return true;
+	}
+
+	template <typename Type, typename Hash>
+	void ComponentCollection<Shared<Type, Hash>>::swap(std::uint32_t lhs, std::uint32_t rhs) {
+		std::swap(components[lhs].entry, components[rhs].entry);
+		Collection::swap(lhs, rhs);
+	}
+
+	/**
+	* @brief Appends all the values of another set, translating them on the way.
+	*
+	* Shared values are interned again in this set, values already known are
+	* shared with the entities of the other set.
+	*/
+	template <typename Type, typename Hash>
+	void ComponentCollection<Shared<Type, Hash>>::merge(Collection& other, const std::vector<EntityId>& table) {
+		auto& source = static_cast<ComponentCollection<Component>&>(other);
+		const auto offset = components.size();
+
+		components.reserve(components.size() + source.components.size());
+
+		for (const auto& component : source.components) {
+			components.push_back(intern(*component));
+		}
+
+		Collection::merge(other, table);
+
+		for (auto listener : listeners) {
+			for (auto i = offset; i < components.size(); ++i) {
+				listener->added(values[i], components[i]);
+			}
+		}
+	}
+
+	template <typename Type, typename Hash>
+	void ComponentCollection<Shared<Type, Hash>>::transfer(EntityId value, Collection& destination, EntityId id) {
+		static_cast<ComponentCollection<Component>&>(destination).emplace(id, get(value));
+		remove(value);
+	}
+
+	template <typename Type, typename Hash>
+	std::unique_ptr<Collection> ComponentCollection<Shared<Type, Hash>>::create() const {
+		return std::make_unique<ComponentCollection<Component>>();
+	}
+
+	/**
+	* @brief Replicates a value into another set of the same type, once per identifier.
+	*
+	* The shared value is interned at most once, all the new entities refer to it.
+	*/
+	template <typename Type, typename Hash>
+	void ComponentCollection<Shared<Type, Hash>>::replicate(EntityId value, Collection& destination, const std::vector<EntityId>& ids) {
+		auto& target = static_cast<ComponentCollection<Component>&>(destination);
+
+		if (!ids.empty()) {
+			const auto component = target.intern(*get(value));
+			const auto offset = target.components.size();
+
+			component.entry->second += std::uint32_t(ids.size()) - 1U;
+			target.components.reserve(offset + ids.size());
+
+			for (std::size_t i = 0U; i < ids.size(); ++i) {
+				target.components.push_back(component);
+			}
+
+			target.Collection::append(ids);
+
+			for (auto listener : target.listeners) {
+				for (auto i = offset; i < target.components.size(); ++i) {
+					listener->added(target.values[i], target.components[i]);
+				}
+			}
+		}
+	}
+
+	/**
+	* @brief Turns this set into a copy of another set of the same type.
+	*
+	* Values are interned again in this set, that is the table of shared
+	* values is rebuilt from scratch.
+	*/
+	template <typename Type, typename Hash>
+	void ComponentCollection<Shared<Type, Hash>>::mirror(const Collection& other) {
+		auto& source = static_cast<const ComponentCollection<Component>&>(other);
+
+		for (auto listener : listeners) {
+			listener->cleared();
+		}
+
+		components.clear();
+		interned.clear();
+		components.reserve(source.components.size());
+
+		for (const auto& component : source.components) {
+			components.push_back(intern(*component));
+		}
+
+		Collection::mirror(other);
+
+		for (auto listener : listeners) {
+			for (std::uint32_t i = 0U, size = this->size(); i < size; ++i) {
+				listener->added(values[i], components[i]);
+			}
+		}
+	}
+
+	template <typename Type, typename Hash>
+	bool ComponentCollection<Shared<Type, Hash>>::add(EntityId value, const Component& component) {
+		return contains(value) ? false : (emplace(value, component), true);
+	}
+
+	template <typename Type, typename Hash>
+	bool ComponentCollection<Shared<Type, Hash>>::update(EntityId value, const Component& component) {
+		return contains(value) ? replace(value, component), true : false; // Execute and return
+	}
+
+	template <typename Type, typename Hash>
+	void ComponentCollection<Shared<Type, Hash>>::accomodate(EntityId value, const Component& component) {
+		contains(value) ? update(value, component) : add(value, component);
+	}
+
+	/**
+	* @brief Assigns a value that another entity already holds, possibly from
+	* another set.
+	*/
+	template <typename Type, typename Hash>
+	Shared<Type, Hash>& ComponentCollection<Shared<Type, Hash>>::emplace(EntityId value, const Component& component) {
+		return insert(value, intern(*component));
+	}
+
+	/**
+	* @brief Interns a value constructed from the given arguments and assigns it.
+	*
+	* @warning
+	* Attempting to emplace a component for a value that is already contained
+	* throws `std::runtime_error`, the set is left untouched.
+	*/
+	template <typename Type, typename Hash>
+	template <typename... Args, typename>
+	Shared<Type, Hash>& ComponentCollection<Shared<Type, Hash>>::emplace(EntityId value, Args&&... args) {
+		return insert(value, intern(std::forward<Args>(args)...));
+	}
+
+	/**
+	* @brief Interns a value and assigns it in place of the one the entity
+	* holds.
+	*
+	* @warning
+	* Attempting to replace a component for a value that isn't contained
+	* throws `std::runtime_error`, the set is left untouched.
+	*/
+	template <typename Type, typename Hash>
+	Shared<Type, Hash>& ComponentCollection<Shared<Type, Hash>>::replace(EntityId value, const Component& component) {
+		return assign(value, intern(*component));
+	}
+
+	template <typename Type, typename Hash>
+	template <typename... Args, typename>
+	Shared<Type, Hash>& ComponentCollection<Shared<Type, Hash>>::replace(EntityId value, Args&&... args) {
+		return assign(value, intern(std::forward<Args>(args)...));
+	}
+
+	template <typename Type, typename Hash>
+	Shared<Type, Hash>& ComponentCollection<Shared<Type, Hash>>::get(EntityId value) {
+		return components[position(value)];
+	}
+
+	template <typename Type, typename Hash>
+	Shared<Type, Hash>* ComponentCollection<Shared<Type, Hash>>::raw() {
+		return components.data();
+	}
+
+	template <typename Type, typename Hash>
+	const Shared<Type, Hash>* ComponentCollection<Shared<Type, Hash>>::raw() const {
+		return components.data();
+	}
+
+	/**
+	* @brief Returns the number of distinct values in the set.
+	*/
+	template <typename Type, typename Hash>
+	std::uint32_t ComponentCollection<Shared<Type, Hash>>::distinct() const {
+		return std::uint32_t(interned.size());
+	}
+
+	/**
+	* @brief Shared sets have no cold tier, values interned once are already cheap.
+	*/
+	template <typename Type, typename Hash>
+	bool ComponentCollection<Shared<Type, Hash>>::frozen(EntityId) const {
+		return false;
+	}
+
+	template <typename Type, typename Hash>
+	std::uint32_t ComponentCollection<Shared<Type, Hash>>::frozen() const {
+		return 0U;
+	}
+
+	template <typename Type, typename Hash>
+	void ComponentCollection<Shared<Type, Hash>>::thaw() {}
+
+	template <typename Type, typename Hash>
+	void ComponentCollection<Shared<Type, Hash>>::touch(EntityId) {}
+
+	template <typename Type, typename Hash>
+	void ComponentCollection<Shared<Type, Hash>>::touch() {}
+
+	/**
+	* @brief Iterates the entities grouped by shared value.
+	*
+	* The packed array is sorted first, so that entities that share a value are
+	* contiguous. Sorting is skipped as long as the groups are left untouched.
+	* The function object is invoked once per distinct value, with the value
+	* and the range of entities that share it.<br/>
+	* The signature of the function should be equivalent to the following:
+	*
+	* @code{.cpp}
+	* void(const Type&, const EntityId*, const EntityId*);
+	* @endcode
+	*/
+	template <typename Type, typename Hash>
+	template <typename Function>
+	void ComponentCollection<Shared<Type, Hash>>::group(Function function) {
+		arrange();
+
+		for (std::uint32_t first = 0U, last = 0U, size = this->size(); first < size; first = last) {
+			for (last = first + 1U; last < size && components[last] == components[first]; ++last);
+			function(*components[first], values.data() + first, values.data() + last);
+		}
+	}
+
+	template <typename Type, typename Hash>
+	void ComponentCollection<Shared<Type, Hash>>::listen(ComponentListener<Component>* listener) {
+		listeners.push_back(listener);
+	}
+
+	template <typename Type, typename Hash>
+	void ComponentCollection<Shared<Type, Hash>>::unlisten(ComponentListener<Component>* listener) {
+		listeners.erase(std::remove(listeners.begin(), listeners.end(), listener), listeners.end());
+	}
+
+	/**
+	* @brief Reports all the handles to a listener as added ones.
+	*/
+	template <typename Type, typename Hash>
+	void ComponentCollection<Shared<Type, Hash>>::report(ComponentListener<Component>& listener) {
+		for (std::uint32_t i = 0U, size = this->size(); i < size; ++i) {
+			listener.added(values[i], components[i]);
+		}
+	}
+
+	template <typename Type, typename Hash>
+	template <typename... Args>
+	Shared<Type, Hash> ComponentCollection<Shared<Type, Hash>>::intern(Args&&... args) {
+		auto value = Type(std::forward<Args>(args)...);
+		auto found = interned.find(value);
+
+		if (found == interned.end()) {
+			found = interned.emplace(std::move(value), 0U).first;
+		}
+
+		++found->second;
+
+		return Component(&*found);
+	}
+
+	template <typename Type, typename Hash>
+	void ComponentCollection<Shared<Type, Hash>>::release(const Component& component) {
+		if (--component.entry->second == 0U) {
+			interned.erase(interned.find(component.entry->first)); // The key lives in the erased node
+		}
+	}
+
+	template <typename Type, typename Hash>
+	Shared<Type, Hash>& ComponentCollection<Shared<Type, Hash>>::insert(EntityId value, Component component) {
+		if (contains(value)) {
+			release(component);
+			throw std::runtime_error("Component already assigned");
+		}
+
+		components.push_back(component);
+		Collection::add(value);
+
+		for (auto listener : listeners) {
+			listener->added(value, components.back());
+		}
+
+		return components.back();
+	}
+
+	template <typename Type, typename Hash>
+	Shared<Type, Hash>& ComponentCollection<Shared<Type, Hash>>::assign(EntityId value, Component component) {
+		if (!contains(value)) {
+			release(component);
+			throw std::runtime_error("Component not assigned");
+		}
+
+		auto& current = components[position(value)];
+
+		// The new value is interned first, so that replacing a value with itself doesn't drop it
+		release(current);
+		current = component;
+		++changes;
+
+		for (auto listener : listeners) {
+			listener->replaced(value, current);
+		}
+
+		return current;
+	}
+
+	template <typename Type, typename Hash>
+	void ComponentCollection<Shared<Type, Hash>>::arrange() {
+		auto less = [](const Component& lhs, const Component& rhs) {
+			return std::less<const void*>()(lhs.entry, rhs.entry);
+		};
+
+		if (!std::is_sorted(components.cbegin(), components.cend(), less)) {
+			auto order = std::vector<std::uint32_t>(components.size());
+			auto sorted = std::vector<EntityId>();
+
+			for (std::uint32_t i = 0U; i < order.size(); ++i) {
+				order[i] = i;
+			}
+
+			std::sort(order.begin(), order.end(), [this, &less](std::uint32_t lhs, std::uint32_t rhs) {
+				return less(components[lhs], components[rhs]);
+			});
+
+			auto handles = std::vector<Component>();
+
+			sorted.reserve(order.size());
+			handles.reserve(order.size());
+
+			for (auto index : order) {
+				sorted.push_back(values[index]);
+				handles.push_back(components[index]);
+			}
+
+			values.swap(sorted);
+			components.swap(handles);
+
+			for (std::uint32_t i = 0U; i < values.size(); ++i) {
+				indices[values[i] & Entity::ID_MASK] = i;
+			}
+
+			++changes;
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,76 @@
+#ifndef COMPONENT_INDEX_HASH_INDEX_H
+#define COMPONENT_INDEX_HASH_INDEX_H
+
+#include <vector>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include "../Container/ComponentListener.h"
+#include "../../Entity/EntityTraits.h"
+
+namespace cs
+{
+	/**
+	* @brief Equality index of entities keyed on a data member of a component.
+	*
+	* A hash index buckets entities according to the value of the given field
+	* of their component, so that finding the entities with a given value
+	* doesn't require a scan of the set. It's a listener, therefore once
+	* registered through `EntityManager::observe` it's incrementally kept up to
+	* date whenever the component is assigned, replaced or removed (destroyed
+	* entities included).
+	*
+	* @note
+	* Fields modified in place through a reference aren't tracked. Use
+	* `replace` or `accomodate` to change the key of an entity.
+	*
+	* @note
+	* Keys are copied into the index, they must be default constructible, copy
+	* assignable and comparable for equality.
+	*
+	* @tparam Component Type of component that holds the key.
+	* @tparam Key Type of the data member used as key.
+	* @tparam Hash Type of hash function for the keys.
+	*/
+	template <typename Component, typename Key, typename Hash = std::hash<Key>>
+	class HashIndex final : public ComponentListener<Component>
+	{
+	public:
+		explicit HashIndex(Key Component::* field, Hash hash = Hash());
+		HashIndex(const HashIndex&) = delete;
+		HashIndex(HashIndex&&) = default;
+
+		void added(EntityId value, const Component& component) override;
+		void replaced(EntityId value, const Component& component) override;
+		void removed(EntityId value, const Component& component) override;
+		void cleared() override;
+
+		bool empty() const;
+		std::uint32_t size() const;
+		bool contains(EntityId value) const;
+
+		EntityId find(const Key& key) const;
+		std::uint32_t count(const Key& key) const;
+		const std::vector<EntityId>& equal(const Key& key) const;
+
+	private:
+		struct Entry
+		{
+			Key key;
+			std::uint32_t slot; // Position within the bucket
+			EntityId value;
+		};
+
+		void insert(EntityId value, const Key& key);
+		void erase(EntityId value);
+
+	private:
+		Key Component::* field;
+		std::uint32_t total;
+		std::vector<Entry> entries; // Indexed by entity, without version
+		std::unordered_map<Key, std::vector<EntityId>, Hash> buckets;
+		std::vector<EntityId> none; // Returned for the keys that aren't in use
+	};
+}
+
+#endif
@@ -0,0 +1,141 @@
+#ifndef COMPONENT_INDEX_HASH_INDEX_IMPL
+#define COMPONENT_INDEX_HASH_INDEX_IMPL
+
+#include <cassert>
+#include "HashIndex.h"
+#include "../../Entity/Entity.h"
+
+namespace cs
+{
+	/**
+	* @brief Constructs an empty hash index.
+	* @param field Data member of the component used as key.
+	* @param hash Hash function for the keys.
+	*/
+	template <typename Component, typename Key, typename Hash>
+	HashIndex<Component, Key, Hash>::HashIndex(Key Component::* field, Hash hash)
+		: field(field)
+		, total(0U)
+		, buckets(0U, hash)
+	{
+		assert(field != nullptr);
+	}
+
+	template <typename Component, typename Key, typename Hash>
+	void HashIndex<Component, Key, Hash>::added(EntityId value, const Component& component) {
+		insert(value, component.*field);
+	}
+
+	template <typename Component, typename Key, typename Hash>
+	void HashIndex<Component, Key, Hash>::replaced(EntityId value, const Component& component) {
+		if (!contains(value)) {
+			insert(value, component.*field);
+			return;
+		}
+
+		// Entities that kept their key don't need to be moved around
+		if (!(entries[value & Entity::ID_MASK].key == component.*field)) {
+			erase(value);
+			insert(value, component.*field);
+		}
+	}
+
+	template <typename Component, typename Key, typename Hash>
+	void HashIndex<Component, Key, Hash>::removed(EntityId value, const Component&) {
+		if (contains(value)) {
+			erase(value);
+		}
+	}
+
+	template <typename Component, typename Key, typename Hash>
+	void HashIndex<Component, Key, Hash>::cleared() {
+		total = 0U;
+		entries.clear();
+		buckets.clear();
+	}
+
+	template <typename Component, typename Key, typename Hash>
+	bool HashIndex<Component, Key, Hash>::empty() const {
+		return total == 0U;
+	}
+
+	template <typename Component, typename Key, typename Hash>
+	std::uint32_t HashIndex<Component, Key, Hash>::size() const {
+		return total;
+	}
+
+	template <typename Component, typename Key, typename Hash>
+	bool HashIndex<Component, Key, Hash>::contains(EntityId value) const {
+		const auto index = value & Entity::ID_MASK;
+		return index < entries.size() && entries[index].value == value;
+	}
+
+	/**
+	* @brief Returns an entity whose key is equal to the given one.
+	*
+	* Meant for unique keys, such as network identifiers. When several entities
+	* share the key, the one returned is unspecified.
+	*
+	* @return The entity found, Entity::INVALID otherwise.
+	*/
+	template <typename Component, typename Key, typename Hash>
+	EntityId HashIndex<Component, Key, Hash>::find(const Key& key) const {
+		const auto found = buckets.find(key);
+		return found != buckets.end() ? found->second.front() : Entity::INVALID;
+	}
+
+	template <typename Component, typename Key, typename Hash>
+	std::uint32_t HashIndex<Component, Key, Hash>::count(const Key& key) const {
+		const auto found = buckets.find(key);
+		return found != buckets.end() ? std::uint32_t(found->second.size()) : 0U;
+	}
+
+	/**
+	* @brief Returns all the entities whose key is equal to the given one.
+	*
+	* The reference is invalidated by the next change to the index, copy the
+	* entities first when the loop modifies the component.
+	*/
+	template <typename Component, typename Key, typename Hash>
+	const std::vector<EntityId>& HashIndex<Component, Key, Hash>::equal(const Key& key) const {
+		const auto found = buckets.find(key);
+		return found != buckets.end() ? found->second : none;
+	}
+
+	template <typename Component, typename Key, typename Hash>
+	void HashIndex<Component, Key, Hash>::insert(EntityId value, const Key& key) {
+		const auto index = value & Entity::ID_MASK;
+
+		if (index >= entries.size()) {
+			entries.resize(index + 1U, Entry{ Key(), 0U, Entity::INVALID });
+		}
+
+		auto& bucket = buckets[key];
+
+		entries[index] = Entry{ key, std::uint32_t(bucket.size()), value };
+		bucket.push_back(value);
+		++total;
+	}
+
+	template <typename Component, typename Key, typename Hash>
+	void HashIndex<Component, Key, Hash>::erase(EntityId value) {
+		auto& entry = entries[value & Entity::ID_MASK];
+		auto found = buckets.find(entry.key);
+		auto& bucket = found->second;
+		const auto last = bucket.back();
+
+		// Swap and pop within the bucket, the moved entity keeps track of its new slot
+		bucket[entry.slot] = last;
+		entries[last & Entity::ID_MASK].slot = entry.slot;
+		bucket.pop_back();
+
+		if (bucket.empty()) {
+			buckets.erase(found);
+		}
+
+		entry.value = Entity::INVALID;
+		--total;
+	}
+}
+
+#endif
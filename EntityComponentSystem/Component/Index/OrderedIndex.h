@@ -0,0 +1,76 @@
+#ifndef COMPONENT_INDEX_ORDERED_INDEX_H
+#define COMPONENT_INDEX_ORDERED_INDEX_H
+
+#include <map>
+#include <vector>
+#include <cstdint>
+#include <functional>
+#include "../Container/ComponentListener.h"
+#include "../../Entity/EntityTraits.h"
+
+namespace cs
+{
+	/**
+	* @brief Range index of entities keyed on a data member of a component.
+	*
+	* An ordered index keeps entities sorted according to the value of the
+	* given field of their component, so that the entities within a range of
+	* values are found without a scan of the set. It's a listener, therefore
+	* once registered through `EntityManager::observe` it's incrementally kept
+	* up to date whenever the component is assigned, replaced or removed
+	* (destroyed entities included).<br/>
+	* Queries visit the entities in increasing order of key. Entities that
+	* share a key are visited in the order they got it.
+	*
+	* @note
+	* Fields modified in place through a reference aren't tracked. Use
+	* `replace` or `accomodate` to change the key of an entity.
+	*
+	* @tparam Component Type of component that holds the key.
+	* @tparam Key Type of the data member used as key.
+	* @tparam Compare Type of function that orders the keys.
+	*/
+	template <typename Component, typename Key, typename Compare = std::less<Key>>
+	class OrderedIndex final : public ComponentListener<Component>
+	{
+	public:
+		explicit OrderedIndex(Key Component::* field, Compare compare = Compare());
+		OrderedIndex(const OrderedIndex&) = delete;
+		OrderedIndex(OrderedIndex&&) = default;
+
+		void added(EntityId value, const Component& component) override;
+		void replaced(EntityId value, const Component& component) override;
+		void removed(EntityId value, const Component& component) override;
+		void cleared() override;
+
+		bool empty() const;
+		std::uint32_t size() const;
+		bool contains(EntityId value) const;
+
+		template <typename Function>
+		void query(const Key& from, const Key& to, Function function) const;
+
+		std::vector<EntityId> range(const Key& from, const Key& to) const;
+		std::vector<EntityId> below(const Key& key) const;
+		std::vector<EntityId> above(const Key& key) const;
+
+	private:
+		using Tree = std::multimap<Key, EntityId, Compare>;
+
+		struct Entry
+		{
+			typename Tree::iterator node;
+			EntityId value;
+		};
+
+		void insert(EntityId value, const Key& key);
+		void erase(EntityId value);
+
+	private:
+		Key Component::* field;
+		Tree tree;
+		std::vector<Entry> entries; // Indexed by entity, without version
+	};
+}
+
+#endif
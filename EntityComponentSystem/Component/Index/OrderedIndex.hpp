@@ -0,0 +1,161 @@
+#ifndef COMPONENT_INDEX_ORDERED_INDEX_IMPL
+#define COMPONENT_INDEX_ORDERED_INDEX_IMPL
+
+#include <cassert>
+#include "OrderedIndex.h"
+#include "../../Entity/Entity.h"
+
+namespace cs
+{
+	/**
+	* @brief Constructs an empty ordered index.
+	* @param field Data member of the component used as key.
+	* @param compare Function that orders the keys.
+	*/
+	template <typename Component, typename Key, typename Compare>
+	OrderedIndex<Component, Key, Compare>::OrderedIndex(Key Component::* field, Compare compare)
+		: field(field)
+		, tree(compare)
+	{
+		assert(field != nullptr);
+	}
+
+	template <typename Component, typename Key, typename Compare>
+	void OrderedIndex<Component, Key, Compare>::added(EntityId value, const Component& component) {
+		insert(value, component.*field);
+	}
+
+	template <typename Component, typename Key, typename Compare>
+	void OrderedIndex<Component, Key, Compare>::replaced(EntityId value, const Component& component) {
+		if (!contains(value)) {
+			insert(value, component.*field);
+			return;
+		}
+
+		const auto& key = entries[value & Entity::ID_MASK].node->first;
+		const auto& compare = tree.key_comp();
+
+		// Entities that kept their key don't need to be moved around
+		if (compare(key, component.*field) || compare(component.*field, key)) {
+			erase(value);
+			insert(value, component.*field);
+		}
+	}
+
+	template <typename Component, typename Key, typename Compare>
+	void OrderedIndex<Component, Key, Compare>::removed(EntityId value, const Component&) {
+		if (contains(value)) {
+			erase(value);
+		}
+	}
+
+	template <typename Component, typename Key, typename Compare>
+	void OrderedIndex<Component, Key, Compare>::cleared() {
+		tree.clear();
+		entries.clear();
+	}
+
+	template <typename Component, typename Key, typename Compare>
+	bool OrderedIndex<Component, Key, Compare>::empty() const {
+		return tree.empty();
+	}
+
+	template <typename Component, typename Key, typename Compare>
+	std::uint32_t OrderedIndex<Component, Key, Compare>::size() const {
+		return std::uint32_t(tree.size());
+	}
+
+	template <typename Component, typename Key, typename Compare>
+	bool OrderedIndex<Component, Key, Compare>::contains(EntityId value) const {
+		const auto index = value & Entity::ID_MASK;
+		return index < entries.size() && entries[index].value == value;
+	}
+
+	/**
+	* @brief Iterates the entities whose key lies within a given range.
+	*
+	* The signature of the function should be equivalent to the following:
+	*
+	* @code{.cpp}
+	* void(EntityId);
+	* @endcode
+	*
+	* @param from Lower bound of the range, inclusive.
+	* @param to Upper bound of the range, exclusive.
+	* @param function A valid function object.
+	*/
+	template <typename Component, typename Key, typename Compare>
+	template <typename Function>
+	void OrderedIndex<Component, Key, Compare>::query(const Key& from, const Key& to, Function function) const {
+		if (tree.key_comp()(from, to)) {
+			for (auto it = tree.lower_bound(from), last = tree.lower_bound(to); it != last; ++it) {
+				function(it->second);
+			}
+		}
+	}
+
+	/**
+	* @brief Returns the entities whose key lies within `[from, to)`.
+	*/
+	template <typename Component, typename Key, typename Compare>
+	std::vector<EntityId> OrderedIndex<Component, Key, Compare>::range(const Key& from, const Key& to) const {
+		std::vector<EntityId> result;
+
+		query(from, to, [&result](EntityId value) {
+			result.push_back(value);
+		});
+
+		return result;
+	}
+
+	/**
+	* @brief Returns the entities whose key is lower than the given one.
+	*/
+	template <typename Component, typename Key, typename Compare>
+	std::vector<EntityId> OrderedIndex<Component, Key, Compare>::below(const Key& key) const {
+		std::vector<EntityId> result;
+
+		for (auto it = tree.begin(), last = tree.lower_bound(key); it != last; ++it) {
+			result.push_back(it->second);
+		}
+
+		return result;
+	}
+
+	/**
+	* @brief Returns the entities whose key is greater than the given one.
+	*/
+	template <typename Component, typename Key, typename Compare>
+	std::vector<EntityId> OrderedIndex<Component, Key, Compare>::above(const Key& key) const {
+		std::vector<EntityId> result;
+
+		for (auto it = tree.upper_bound(key); it != tree.end(); ++it) {
+			result.push_back(it->second);
+		}
+
+		return result;
+	}
+
+	template <typename Component, typename Key, typename Compare>
+	void OrderedIndex<Component, Key, Compare>::insert(EntityId value, const Key& key) {
+		const auto index = value & Entity::ID_MASK;
+
+		if (index >= entries.size()) {
+			entries.resize(index + 1U, Entry{ tree.end(), Entity::INVALID });
+		}
+
+		// Inserted past the entities with an equivalent key, thus they keep their order
+		entries[index] = Entry{ tree.emplace(key, value), value };
+	}
+
+	template <typename Component, typename Key, typename Compare>
+	void OrderedIndex<Component, Key, Compare>::erase(EntityId value) {
+		auto& entry = entries[value & Entity::ID_MASK];
+
+		tree.erase(entry.node);
+		entry.node = tree.end();
+		entry.value = Entity::INVALID;
+	}
+}
+
+#endif
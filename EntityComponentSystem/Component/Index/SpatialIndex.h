@@ -0,0 +1,111 @@
+#ifndef COMPONENT_INDEX_SPATIAL_INDEX_H
+#define COMPONENT_INDEX_SPATIAL_INDEX_H
+
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+#include "../Container/ComponentListener.h"
+#include "../../Entity/EntityTraits.h"
+
+namespace cs
+{
+	/**
+	* @brief Default locator of spatial indices.
+	*
+	* Reads the coordinates of a component from its `x` and `y` data members.
+	* Specialize it (or provide another locator type) for components that
+	* store their position in a different way.
+	*
+	* @tparam Component Type of component that holds the position.
+	*/
+	template <typename Component>
+	struct SpatialLocator
+	{
+		float x(const Component& component) const {
+			return float(component.x);
+		}
+
+		float y(const Component& component) const {
+			return float(component.y);
+		}
+	};
+
+	/**
+	* @brief Uniform grid of entities keyed on a position component.
+	*
+	* A spatial index buckets entities into square cells according to the
+	* position read from the given component. It's a listener, therefore once
+	* registered through `EntityManager::observe` it's incrementally kept up to
+	* date whenever the component is assigned, replaced or removed (destroyed
+	* entities included).<br/>
+	* Range queries only visit the cells that overlap the query area, nearest
+	* neighbours queries expand ring by ring around the cell of the query point.
+	*
+	* @note
+	* Positions modified in place through a reference aren't tracked. Use
+	* `replace` or `accomodate` to move entities around.
+	*
+	* @note
+	* Positions far away from the origin (past half a billion cells) are
+	* clamped to the border of the grid, those that aren't a number to its
+	* origin. Queries still test the actual positions.
+	*
+	* @note
+	* Pick a cell size close to the typical query radius: too small cells
+	* means many empty cells visited, too large cells means many entities
+	* tested for nothing.
+	*
+	* @tparam Component Type of component that holds the position.
+	* @tparam Locator Type used to read the coordinates from the component.
+	*/
+	template <typename Component, typename Locator = SpatialLocator<Component>>
+	class SpatialIndex final : public ComponentListener<Component>
+	{
+	public:
+		explicit SpatialIndex(float cell, Locator locator = Locator());
+		SpatialIndex(const SpatialIndex&) = delete;
+		SpatialIndex(SpatialIndex&&) = default;
+
+		void added(EntityId value, const Component& component) override;
+		void replaced(EntityId value, const Component& component) override;
+		void removed(EntityId value, const Component& component) override;
+		void cleared() override;
+
+		bool empty() const;
+		std::uint32_t size() const;
+		bool contains(EntityId value) const;
+
+		template <typename Function>
+		void query(float x, float y, float radius, Function function) const;
+
+		std::vector<EntityId> range(float x, float y, float radius) const;
+		std::vector<EntityId> nearest(float x, float y, std::uint32_t amount) const;
+
+	private:
+		static const std::int32_t LIMIT = 1 << 29; // Cells beyond are clamped, see coordinate
+
+		struct Entry
+		{
+			float x;
+			float y;
+			std::uint64_t cell;
+			std::uint32_t slot; // Position within the cell
+			EntityId value;
+		};
+
+		std::int32_t coordinate(float value) const;
+		std::uint64_t key(std::int32_t x, std::int32_t y) const;
+		void insert(EntityId value, float x, float y);
+		void erase(EntityId value);
+
+	private:
+		float cell;
+		Locator locator;
+		std::uint32_t count;
+		std::int32_t left, right, bottom, top; // Bounds of the occupied cells, never shrunk
+		std::vector<Entry> entries; // Indexed by entity, without version
+		std::unordered_map<std::uint64_t, std::vector<EntityId>> cells;
+	};
+}
+
+#endif
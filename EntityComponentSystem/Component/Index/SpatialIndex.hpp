@@ -0,0 +1,339 @@
+#ifndef COMPONENT_INDEX_SPATIAL_INDEX_IMPL
+#define COMPONENT_INDEX_SPATIAL_INDEX_IMPL
+
+#include <cmath>
+#include <cassert>
+#include <utility>
+#include <algorithm>
+#include "SpatialIndex.h"
+#include "../../Entity/Entity.h"
+
+namespace cs
+{
+	template <typename Component, typename Locator>
+	const std::int32_t SpatialIndex<Component, Locator>::LIMIT;
+
+	/**
+	* @brief Constructs an empty spatial index.
+	* @param cell Size of the side of the cells of the grid.
+	* @param locator Object used to read the coordinates from the components.
+	*/
+	template <typename Component, typename Locator>
+	SpatialIndex<Component, Locator>::SpatialIndex(float cell, Locator locator)
+		: cell(cell)
+		, locator(locator)
+		, count(0U)
+		, left(0), right(-1), bottom(0), top(-1)
+	{
+		assert(cell > 0.f);
+	}
+
+	template <typename Component, typename Locator>
+	void SpatialIndex<Component, Locator>::added(EntityId value, const Component& component) {
+		insert(value, locator.x(component), locator.y(component));
+	}
+
+	template <typename Component, typename Locator>
+	void SpatialIndex<Component, Locator>::replaced(EntityId value, const Component& component) {
+		const auto x = locator.x(component);
+		const auto y = locator.y(component);
+
+		// Entities the index doesn't know yet (registered late, as an example) are simply added
+		if (!contains(value)) {
+			insert(value, x, y);
+			return;
+		}
+
+		auto& entry = entries[value & Entity::ID_MASK];
+
+		// Entities that didn't leave their cell don't need to be moved around
+		if (entry.cell == key(coordinate(x), coordinate(y))) {
+			entry.x = x;
+			entry.y = y;
+		}
+		else {
+			erase(value);
+			insert(value, x, y);
+		}
+	}
+
+	template <typename Component, typename Locator>
+	void SpatialIndex<Component, Locator>::removed(EntityId value, const Component&) {
+		if (contains(value)) {
+			erase(value);
+		}
+	}
+
+	template <typename Component, typename Locator>
+	void SpatialIndex<Component, Locator>::cleared() {
+		count = 0U;
+		left = bottom = 0;
+		right = top = -1;
+		entries.clear();
+		cells.clear();
+	}
+
+	template <typename Component, typename Locator>
+	bool SpatialIndex<Component, Locator>::empty() const {
+		return count == 0U;
+	}
+
+	template <typename Component, typename Locator>
+	std::uint32_t SpatialIndex<Component, Locator>::size() const {
+		return count;
+	}
+
+	template <typename Component, typename Locator>
+	bool SpatialIndex<Component, Locator>::contains(EntityId value) const {
+		const auto index = value & Entity::ID_MASK;
+		return index < entries.size() && entries[index].value == value;
+	}
+
+	/**
+	* @brief Iterates the entities within a given distance from a point.
+	*
+	* The signature of the function should be equivalent to the following:
+	*
+	* @code{.cpp}
+	* void(EntityId);
+	* @endcode
+	*
+	* @param x Horizontal coordinate of the center of the query.
+	* @param y Vertical coordinate of the center of the query.
+	* @param radius Maximum distance from the center, inclusive.
+	* @param function A valid function object.
+	*/
+	template <typename Component, typename Locator>
+	template <typename Function>
+	void SpatialIndex<Component, Locator>::query(float x, float y, float radius, Function function) const {
+		const auto squared = radius * radius;
+		const auto xmin = std::max(coordinate(x - radius), left);
+		const auto xmax = std::min(coordinate(x + radius), right);
+		const auto ymin = std::max(coordinate(y - radius), bottom);
+		const auto ymax = std::min(coordinate(y + radius), top);
+
+		for (auto cx = xmin; cx <= xmax; ++cx) {
+			for (auto cy = ymin; cy <= ymax; ++cy) {
+				const auto found = cells.find(key(cx, cy));
+
+				if (found != cells.end()) {
+					for (auto value : found->second) {
+						const auto& entry = entries[value & Entity::ID_MASK];
+						const auto dx = entry.x - x;
+						const auto dy = entry.y - y;
+
+						if (dx * dx + dy * dy <= squared) {
+							function(value);
+						}
+					}
+				}
+			}
+		}
+	}
+
+	/**
+	* @brief Returns the entities within a given distance from a point.
+	*/
+	template <typename Component, typename Locator>
+	std::vector<EntityId> SpatialIndex<Component, Locator>::range(float x, float y, float radius) const {
+		std::vector<EntityId> result;
+
+		query(x, y, radius, [&result](EntityId value) {
+			result.push_back(value);
+		});
+
+		return result;
+	}
+
+	/**
+	* @brief Returns the entities closest to a point, nearest first.
+	*
+	* Cells are visited ring by ring around the one of the query point. The
+	* search stops as soon as no unvisited cell can contain an entity closer
+	* than the farthest of the candidates found so far. When the rings would
+	* visit many more cells than there are occupied ones, these are scanned
+	* directly instead.
+	*
+	* @param x Horizontal coordinate of the query point.
+	* @param y Vertical coordinate of the query point.
+	* @param amount Maximum number of entities to return.
+	*/
+	template <typename Component, typename Locator>
+	std::vector<EntityId> SpatialIndex<Component, Locator>::nearest(float x, float y, std::uint32_t amount) const {
+		using Candidate = std::pair<float, EntityId>;
+
+		std::vector<Candidate> heap; // Max heap on the distance, the farthest candidate on top
+		std::vector<EntityId> result;
+
+		if (amount == 0U || empty()) {
+			return result;
+		}
+
+		const auto cx = coordinate(x);
+		const auto cy = coordinate(y);
+
+		auto consider = [&](const std::vector<EntityId>& bucket) {
+			for (auto value : bucket) {
+				const auto& entry = entries[value & Entity::ID_MASK];
+				const auto dx = entry.x - x;
+				const auto dy = entry.y - y;
+				const auto distance = dx * dx + dy * dy;
+
+				if (heap.size() < amount) {
+					heap.emplace_back(distance, value);
+					std::push_heap(heap.begin(), heap.end());
+				}
+				else if (distance < heap.front().first) {
+					std::pop_heap(heap.begin(), heap.end());
+					heap.back() = Candidate(distance, value);
+					std::push_heap(heap.begin(), heap.end());
+				}
+			}
+		};
+
+		auto visit = [&](std::int32_t i, std::int32_t j) {
+			const auto found = cells.find(key(i, j));
+
+			if (found != cells.end()) {
+				consider(found->second);
+			}
+		};
+
+		// Rings closer than the occupied bounds are empty and can be skipped altogether
+		const auto first = std::max({ 0, left - cx, cx - right, bottom - cy, cy - top });
+		auto probed = std::size_t(0);
+
+		for (auto ring = first; ; ++ring) {
+			// Rings entirely outside the occupied bounds can't contain anything
+			if (cx - ring < left && cx + ring > right && cy - ring < bottom && cy + ring > top) {
+				break;
+			}
+
+			// Mostly empty grids (far away entities, as an example) are cheaper to scan as a whole
+			probed += ring ? std::size_t(ring) * 8U : 1U;
+
+			if (probed > 2U * cells.size() + 8U) {
+				heap.clear();
+
+				for (const auto& cell : cells) {
+					consider(cell.second);
+				}
+
+				break;
+			}
+
+			const auto xmin = std::max(cx - ring, left);
+			const auto xmax = std::min(cx + ring, right);
+			const auto ymin = std::max(cy - ring + 1, bottom);
+			const auto ymax = std::min(cy + ring - 1, top);
+
+			for (auto i = xmin; i <= xmax; ++i) {
+				if (cy - ring >= bottom) {
+					visit(i, cy - ring);
+				}
+
+				if (ring && cy + ring <= top) {
+					visit(i, cy + ring);
+				}
+			}
+
+			for (auto j = ymin; j <= ymax; ++j) {
+				if (cx - ring >= left) {
+					visit(cx - ring, j);
+				}
+
+				if (ring && cx + ring <= right) {
+					visit(cx + ring, j);
+				}
+			}
+
+			// Cells of the next ring are at least `ring` cells away from the query point
+			const auto bound = float(ring) * cell;
+
+			if (heap.size() == amount && heap.front().first <= bound * bound) {
+				break;
+			}
+		}
+
+		std::sort_heap(heap.begin(), heap.end());
+		result.reserve(heap.size());
+
+		for (const auto& candidate : heap) {
+			result.push_back(candidate.second);
+		}
+
+		return result;
+	}
+
+	/**
+	* @brief Returns the cell of a coordinate along one axis.
+	*
+	* Cells are clamped within `LIMIT` of the origin, so that the arithmetic on
+	* them can't overflow. Coordinates that aren't a number fall in the cell of
+	* the origin.
+	*/
+	template <typename Component, typename Locator>
+	std::int32_t SpatialIndex<Component, Locator>::coordinate(float value) const {
+		const auto scaled = std::floor(value / cell);
+
+		if (std::isnan(scaled)) {
+			return 0;
+		}
+
+		return std::int32_t(std::max(-float(LIMIT), std::min(scaled, float(LIMIT))));
+	}
+
+	template <typename Component, typename Locator>
+	std::uint64_t SpatialIndex<Component, Locator>::key(std::int32_t x, std::int32_t y) const {
+		return (std::uint64_t(std::uint32_t(x)) << 32) | std::uint64_t(std::uint32_t(y));
+	}
+
+	template <typename Component, typename Locator>
+	void SpatialIndex<Component, Locator>::insert(EntityId value, float x, float y) {
+		const auto index = value & Entity::ID_MASK;
+		const auto cx = coordinate(x);
+		const auto cy = coordinate(y);
+
+		if (index >= entries.size()) {
+			entries.resize(index + 1U, Entry{ 0.f, 0.f, 0U, 0U, Entity::INVALID });
+		}
+
+		auto& bucket = cells[key(cx, cy)];
+
+		entries[index] = Entry{ x, y, key(cx, cy), std::uint32_t(bucket.size()), value };
+		bucket.push_back(value);
+
+		if (count++ == 0U) {
+			left = right = cx;
+			bottom = top = cy;
+		}
+		else {
+			left = std::min(left, cx);
+			right = std::max(right, cx);
+			bottom = std::min(bottom, cy);
+			top = std::max(top, cy);
+		}
+	}
+
+	template <typename Component, typename Locator>
+	void SpatialIndex<Component, Locator>::erase(EntityId value) {
+		auto& entry = entries[value & Entity::ID_MASK];
+		auto found = cells.find(entry.cell);
+		auto& bucket = found->second;
+		const auto last = bucket.back();
+
+		// Swap and pop within the cell, the moved entity keeps track of its new slot
+		bucket[entry.slot] = last;
+		entries[last & Entity::ID_MASK].slot = entry.slot;
+		bucket.pop_back();
+
+		if (bucket.empty()) {
+			cells.erase(found);
+		}
+
+		entry.value = Entity::INVALID;
+		--count;
+	}
+}
+
+#endif
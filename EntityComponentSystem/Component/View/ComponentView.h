@@ -1,48 +1,380 @@
 #pragma once
 
+#include <tuple>
+#include <cstddef>
+#include <iterator>
 #include "../Container/ComponentIntersection.hpp"
+#include "../../Profile/Profiler.h"
 
 namespace cs
 {
 	class EntityManager;
 
+	/**
+	* @brief Multi component view.
+	*
+	* Iterates the entities that have all the given components. It's a range:
+	* its iterators walk the smallest of the sets and skip the entities that
+	* the other sets don't contain, thus it can be used with standard
+	* algorithms.<br/>
+	* Iterators dereference to a tuple made of the entity and references to its
+	* components, in the order of the template parameters.
+	*
+	* @note
+	* Tuples are built on the fly, thus iterators are input iterators as far as
+	* the standard library is concerned. They are forward iterators in the
+	* sense of C++20 ranges only (see `iterator_concept`). Use `reduce` to
+	* split the work among several threads.
+	*
+	* @note
+	* Iterators keep pointers to the sets rather than to the view, so they can
+	* outlive it. Assigning or removing the given components invalidates them.
+	*
+	* @tparam Components Types of components iterated by the view.
+	*/
 	template <typename... Components>
 	struct ComponentView
 	{
+		class Iterator final
+		{
+		public:
+			using iterator_category = std::input_iterator_tag; // The reference isn't a true reference
+			using iterator_concept = std::forward_iterator_tag;
+			using value_type = std::tuple<EntityId, Components&...>;
+			using difference_type = std::ptrdiff_t;
+			using pointer = void;
+			using reference = value_type; // Proxy, built on the fly
+
+			Iterator() = default;
+
+			Iterator(const std::tuple<ComponentCollection<Components>*...>& sets, const EntityId* current, const EntityId* last)
+				: sets(sets)
+				, current(current)
+				, last(last)
+			{
+				skip();
+			}
+
+			Iterator& operator++() {
+				return ++current, skip(), *this;
+			}
+
+			Iterator operator++(int) {
+				Iterator orig = *this;
+				return ++(*this), orig;
+			}
+
+			bool operator==(const Iterator& other) const {
+				return other.current == current;
+			}
+
+			bool operator!=(const Iterator& other) const {
+				return other.current != current;
+			}
+
+			reference operator*() const {
+				return reference(*current, std::get<ComponentCollection<Components>*>(sets)->get(*current)...);
+			}
+
+		private:
+			void skip() {
+				while (current != last && !contains(*current)) {
+					++current;
+				}
+			}
+
+			bool contains(EntityId id) const {
+				auto result = true;
+				auto accumulator = { (result = result && std::get<ComponentCollection<Components>*>(sets)->contains(id))... };
+				static_cast<void>(accumulator);
+				return result;
+			}
+
+		private:
+			std::tuple<ComponentCollection<Components>*...> sets;
+			const EntityId* current = nullptr;
+			const EntityId* last = nullptr;
+		};
+
 		ComponentView(cs::EntityManager* manager, cs::ComponentCollection<Components>&... components)
 			: manager(manager)
+			, intersection(components...)
 			, components(components...)
-			, intersection(components...) 
 		{}
 
+		Iterator begin() const {
+			const auto smallest = intersection.candidates();
+			return Iterator(std::make_tuple(&std::get<ComponentCollection<Components>&>(components)...), smallest->data(), smallest->data() + smallest->size());
+		}
+
+		Iterator end() const {
+			const auto smallest = intersection.candidates();
+			const auto last = smallest->data() + smallest->size();
+			return Iterator(std::make_tuple(&std::get<ComponentCollection<Components>&>(components)...), last, last);
+		}
+
 		template <typename Function>
-		void each(Function& function) {
+		void each(Function function) {
+			CS_PROFILE_SCOPE("ComponentView::each");
+			CS_PROFILE_COUNT(candidates());
+
 			for (auto id : intersection) {
 				function(id, std::get<ComponentCollection<Components>&>(components).get(id)...);
 			}
 		}
 
+		/**
+		* @brief Iterates a slice of the candidates, positions of the set that
+		* drives the iteration in `[first, last)`.
+		*/
+		template <typename Function>
+		void each(std::uint32_t first, std::uint32_t last, Function& function) const {
+			const auto ids = intersection.candidates()->data();
+
+			for (auto i = first; i < last; ++i) {
+				const auto id = ids[i];
+				auto result = true;
+				auto accumulator = { (result = result && std::get<ComponentCollection<Components>&>(components).contains(id))... };
+				static_cast<void>(accumulator);
+
+				if (result) {
+					function(id, std::get<ComponentCollection<Components>&>(components).get(id)...);
+				}
+			}
+		}
+
+		/**
+		* @brief Returns the entity stored at an index (version excluded) if it
+		* has all the components, `Entity::INVALID` otherwise.
+		*/
+		EntityId find(std::uint32_t entity) const {
+			const auto id = intersection.candidates()->find(entity);
+			auto result = id != Entity::INVALID;
+			auto accumulator = { (result = result && std::get<ComponentCollection<Components>&>(components).contains(id))... };
+			static_cast<void>(accumulator);
+			return result ? id : Entity::INVALID;
+		}
+
+		/**
+		* @brief Returns an upper bound of the indices of the entities iterated
+		* by the view.
+		*/
+		std::uint32_t span() const {
+			return intersection.candidates()->span();
+		}
+
+		/**
+		* @brief Invokes a function with an entity that is part of the view and
+		* its components.
+		*/
+		template <typename Function>
+		void apply(EntityId id, Function& function) const {
+			function(id, std::get<ComponentCollection<Components>&>(components).get(id)...);
+		}
+
+		/**
+		* @brief Returns the number of candidates, an upper bound of the entities
+		* iterated by the view.
+		*/
+		std::uint32_t candidates() const {
+			return intersection.candidates()->size();
+		}
+
 		const cs::EntityManager* manager;
 		const cs::ComponentIntersection<Components...> intersection;
 		const std::tuple<ComponentCollection<Components>&...> components;
 	};
 
+	/**
+	* @brief Single component view.
+	*
+	* It's a range over the packed arrays of the set. Iterators dereference to
+	* a tuple made of the entity and a reference to its component.
+	*
+	* @note
+	* Iterators are random access, thus the view works with the parallel
+	* standard algorithms as well. Tuples are built on the fly and returned by
+	* value though, write through the references they hold.
+	*
+	* @note
+	* Iterators keep pointers to the packed arrays, thus any insertion or removal
+	* invalidates them.<br/>
+	* Sets with stable removal enabled keep their tombstones (`Entity::INVALID`)
+	* until they are compacted. Iterators and `each` skip them, at the price of
+	* linear time arithmetic: compact these sets before random access.
+	*
+	* @tparam Component Type of component iterated by the view.
+	*/
 	template <typename Component>
 	struct ComponentView<Component> final
 	{
+		class Iterator final
+		{
+		public:
+			using iterator_category = std::random_access_iterator_tag; // The proxy reference is enough for the algorithms
+			using iterator_concept = std::random_access_iterator_tag;
+			using value_type = std::tuple<EntityId, Component&>;
+			using difference_type = std::ptrdiff_t;
+			using pointer = void;
+			using reference = value_type; // Proxy, built on the fly
+
+			Iterator() = default;
+
+			Iterator(const EntityId* ids, Component* components, const EntityId* last, bool sparse)
+				: ids(ids)
+				, components(components)
+				, last(last)
+				, sparse(sparse)
+			{
+				skip();
+			}
+
+			Iterator& operator++() { return ++ids, ++components, skip(), *this; }
+			Iterator operator++(int) { Iterator orig = *this; return ++(*this), orig; }
+			Iterator& operator--() { return --ids, --components, rewind(), *this; }
+			Iterator operator--(int) { Iterator orig = *this; return --(*this), orig; }
+
+			Iterator& operator+=(difference_type n) {
+				if (!sparse) {
+					return ids += n, components += n, *this;
+				}
+
+				for (; n > 0; --n) {
+					++(*this);
+				}
+
+				for (; n < 0; ++n) {
+					--(*this);
+				}
+
+				return *this;
+			}
+
+			Iterator& operator-=(difference_type n) { return *this += -n; }
+			Iterator operator+(difference_type n) const { Iterator copy = *this; return copy += n; }
+			Iterator operator-(difference_type n) const { Iterator copy = *this; return copy -= n; }
+
+			difference_type operator-(const Iterator& other) const {
+				if (!sparse) {
+					return ids - other.ids;
+				}
+
+				const auto forward = other.ids <= ids;
+				auto distance = difference_type(0);
+
+				for (auto id = forward ? other.ids : ids, end = forward ? ids : other.ids; id != end; ++id) {
+					distance += *id != Entity::INVALID ? 1 : 0;
+				}
+
+				return forward ? distance : -distance;
+			}
+
+			friend Iterator operator+(difference_type n, const Iterator& it) { return it + n; }
+
+			bool operator==(const Iterator& other) const { return ids == other.ids; }
+			bool operator!=(const Iterator& other) const { return ids != other.ids; }
+			bool operator<(const Iterator& other) const { return ids < other.ids; }
+			bool operator>(const Iterator& other) const { return ids > other.ids; }
+			bool operator<=(const Iterator& other) const { return ids <= other.ids; }
+			bool operator>=(const Iterator& other) const { return ids >= other.ids; }
+
+			reference operator*() const { assert(*ids != Entity::INVALID); return reference(*ids, *components); }
+			reference operator[](difference_type n) const { return *(*this + n); }
+
+		private:
+			void skip() {
+				while (ids != last && *ids == Entity::INVALID) {
+					++ids;
+					++components;
+				}
+			}
+
+			void rewind() {
+				// Never walks past begin, the first entry that isn't a tombstone
+				while (sparse && *ids == Entity::INVALID) {
+					--ids;
+					--components;
+				}
+			}
+
+		private:
+			const EntityId* ids = nullptr;
+			Component* components = nullptr;
+			const EntityId* last = nullptr;
+			bool sparse = false; // Tombstones to skip, arithmetic walks the entries
+		};
+
 		ComponentView(cs::EntityManager* manager, cs::ComponentCollection<Component>& components)
 			: manager(manager)
 			, components(components)
 		{}
 
+		Iterator begin() const {
+			return Iterator(components.data(), components.raw(), components.data() + components.size(), components.tombstones() != 0U);
+		}
+
+		Iterator end() const {
+			const auto last = components.data() + components.size();
+			return Iterator(last, components.raw() + components.size(), last, components.tombstones() != 0U);
+		}
+
 		template <typename Function>
-		void each(Function& function) {
-			for (auto id : components) {
-				function(id, components.get(id));
+		void each(Function function) {
+			CS_PROFILE_SCOPE("ComponentView::each");
+			CS_PROFILE_COUNT(components.size());
+
+			if (components.tombstones()) {
+				each(0U, components.size(), function);
+			}
+			else {
+				for (auto id : components) {
+					function(id, components.get(id));
+				}
+			}
+		}
+
+		/**
+		* @brief Iterates the entities at positions `[first, last)` of the set.
+		*
+		* Walks the packed arrays directly, with no lookup at all.
+		*/
+		template <typename Function>
+		void each(std::uint32_t first, std::uint32_t last, Function& function) const {
+			const auto ids = components.data();
+			const auto raw = components.raw();
+
+			if (components.tombstones()) {
+				for (auto i = first; i < last; ++i) {
+					if (ids[i] != Entity::INVALID) {
+						function(ids[i], raw[i]);
+					}
+				}
 			}
+			else {
+				for (auto i = first; i < last; ++i) {
+					function(ids[i], raw[i]);
+				}
+			}
+		}
+
+		std::uint32_t candidates() const {
+			return components.size();
+		}
+
+		EntityId find(std::uint32_t entity) const {
+			return components.find(entity);
+		}
+
+		std::uint32_t span() const {
+			return components.span();
+		}
+
+		template <typename Function>
+		void apply(EntityId id, Function& function) const {
+			function(id, components.get(id));
 		}
 
 		cs::EntityManager* manager;
 		cs::ComponentCollection<Component>& components;
 	};
-}
\ No newline at end of file
+}
@@ -74,13 +74,13 @@ namespace cs
 		/**
 		* @brief Iterate the entities and applies them the given function object.
 		*
-		* The function object is invoked for each entity. It is provided with the
-		* entity itself and a set of const references to all the components of the
-		* set.<br/>
+		* The function object is invoked for each entity. It is provided with the entity
+		* identifier (known to be valid, see `EntityManager::get`) and a set of const
+		* references to all the components of the set.<br/>
 		* The signature of the function should be equivalent to the following:
 		*
 		* @code{.cpp}
-		* void(std::uint32_t, const Components&...);
+		* void(EntityId, const Components&...);
 		* @endcode
 		*
 		* @tparam Function Type of the function object to invoke.
@@ -89,19 +89,20 @@ namespace cs
 		template <typename Function>
 		void each(Function function) const {
 			for (auto id : set) {
-				function(Entity(manager, id), std::get<ComponentCollection<Components>&>(sets).get(id)...);
+				function(id, std::get<ComponentCollection<Components>&>(sets).get(id)...);
 			}
 		}
 
 		/**
 		* @brief Iterate the entities and applies them the given function object.
 		*
-		* The function object is invoked for each entity. It is provided with the
-		* entity itself and a set of references to all the components of the set.<br/>
+		* The function object is invoked for each entity. It is provided with the entity
+		* identifier (known to be valid, see `EntityManager::get`) and a set of
+		* references to all the components of the set.<br/>
 		* The signature of the function should be equivalent to the following:
 		*
 		* @code{.cpp}
-		* void(std::uint32_t, Components&...);
+		* void(EntityId, Components&...);
 		* @endcode
 		*
 		* @tparam Function Type of the function object to invoke.
@@ -110,7 +111,7 @@ namespace cs
 		template <typename Function>
 		void each(Function function) {
 			for (auto id : set) {
-				function(Entity(manager, id), std::get<ComponentCollection<Components>&>(sets).get(id)...);
+				function(id, std::get<ComponentCollection<Components>&>(sets).get(id)...);
 			}
 		}
 
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include "../Container/RuntimeCollection.hpp"
+#include "../../Profile/Profiler.h"
+
+namespace cs
+{
+	/**
+	* @brief View of components whose types are known at runtime only.
+	*
+	* Iterates the entities that have all the given components, walking the
+	* smallest of the sets. It's a forward range of identifiers, `each` provides
+	* the components as well (as type-erased pointers, in the order the sets were
+	* given).
+	*
+	* @note
+	* Iterators share the list of sets with the view, so they can outlive it. Assigning or removing the given components invalidates them.
+	*/
+	class RuntimeView final
+	{
+	public:
+		class Iterator final
+		{
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = EntityId;
+			using difference_type = std::ptrdiff_t;
+			using pointer = const EntityId*;
+			using reference = const EntityId&;
+
+			Iterator() = default;
+
+			Iterator(std::shared_ptr<const std::vector<RuntimeCollection*>> sets, const EntityId* current, const EntityId* last)
+				: sets(std::move(sets))
+				, current(current)
+				, last(last)
+			{
+				skip();
+			}
+
+			Iterator& operator++() {
+				return ++current, skip(), *this;
+			}
+
+			Iterator operator++(int) {
+				Iterator orig = *this;
+				return ++(*this), orig;
+			}
+
+			bool operator==(const Iterator& other) const {
+				return other.current == current;
+			}
+
+			bool operator!=(const Iterator& other) const {
+				return other.current != current;
+			}
+
+			reference operator*() const {
+				return *current;
+			}
+
+		private:
+			void skip() {
+				while (current != last && !contains(*current)) {
+					++current;
+				}
+			}
+
+			bool contains(EntityId id) const {
+				for (auto set : *sets) {
+					if (!set->contains(id)) {
+						return false;
+					}
+				}
+
+				return true;
+			}
+
+		private:
+			std::shared_ptr<const std::vector<RuntimeCollection*>> sets;
+			const EntityId* current = nullptr;
+			const EntityId* last = nullptr;
+		};
+
+		explicit RuntimeView(std::vector<RuntimeCollection*> sets)
+			: sets(std::make_shared<const std::vector<RuntimeCollection*>>(std::move(sets)))
+			, smallest(nullptr)
+		{
+			assert(!this->sets->empty());
+			smallest = this->sets->front();
+
+			for (auto set : *this->sets) {
+				smallest = set->size() < smallest->size() ? set : smallest;
+			}
+		}
+
+		Iterator begin() const {
+			return Iterator(sets, smallest->data(), smallest->data() + smallest->size());
+		}
+
+		Iterator end() const {
+			const auto last = smallest->data() + smallest->size();
+			return Iterator(sets, last, last);
+		}
+
+		/**
+		* @brief Iterates the entities and applies them the given function object.
+		*
+		* Views of a single set walk its column directly, with no lookup at all.<br/>
+		* The signature of the function should be equivalent to the following:
+		*
+		* @code{.cpp}
+		* void(EntityId, void**);
+		* @endcode
+		*/
+		template <typename Function>
+		void each(Function function) const {
+			CS_PROFILE_SCOPE("RuntimeView::each");
+
+			const auto& sets = *this->sets;
+			auto components = std::vector<void*>(sets.size());
+			const auto ids = smallest->data();
+
+			if (sets.size() == 1U) {
+				const auto column = smallest->raw();
+				const auto stride = smallest->stride();
+
+				for (std::uint32_t i = 0U, last = smallest->size(); i < last; ++i) {
+					components[0] = column + i * stride;
+					function(ids[i], components.data());
+				}
+			}
+			else {
+				for (auto id : *this) {
+					for (std::size_t i = 0U; i < sets.size(); ++i) {
+						components[i] = sets[i]->get(id);
+					}
+
+					function(id, components.data());
+				}
+			}
+		}
+
+		/**
+		* @brief Returns the number of candidates, an upper bound of the entities
+		* iterated by the view.
+		*/
+		std::uint32_t candidates() const {
+			return smallest->size();
+		}
+
+	private:
+		std::shared_ptr<const std::vector<RuntimeCollection*>> sets; // Shared with the iterators
+		RuntimeCollection* smallest;
+	};
+}
@@ -63,10 +63,10 @@ namespace cs
 		}
 
 		template <typename Function>
-		void each(Function& function) {
+		void each(Function function) {
 			for (auto id : *smallest) {
 				if (intersects(id)) {
-					function(Entity(manager, id), std::get<ComponentCollection<Components>&>(components).get(id)...);
+					function(id, std::get<ComponentCollection<Components>&>(components).get(id)...);
 				}
 			}
 		}
@@ -101,7 +101,7 @@ namespace cs
 		}
 
 	private:
-		inline bool intersects(std::uint32_t id) {
+		inline bool intersects(EntityId id) {
 			auto index = comparables.size();
 			for (; index && comparables[index - 1U]->contains(id); --index);
 			return index == 0U;
@@ -161,42 +161,44 @@ namespace cs
 		/**
 		* @brief Iterate the entities and applies them the given function object.
 		*
-		* The function object is invoked for each entity. It is provided with the
-		* entity itself and a const reference to the component of the view.<br/>
+		* The function object is invoked for each entity. It is provided with the entity
+		* identifier (known to be valid, see `EntityManager::get`) and a const reference
+		* to the component of the view.<br/>
 		* The signature of the function should be equivalent to the following:
 		*
 		* @code{.cpp}
-		* void(cs::Entity, const Component&);
+		* void(EntityId, const Component&);
 		* @endcode
 		*
 		* @tparam Function Type of the function object to invoke.
 		* @param function A intersects function object.
 		*/
 		template <typename Function>
-		void each(Function& function) const {
+		void each(Function function) const {
 			for (auto id : components) {
-				function(Entity(manager, id), components.get(id));
+				function(id, components.get(id));
 			}
 		}
 
 		/**
 		* @brief Iterate the entities and applies them the given function object.
 		*
-		* The function object is invoked for each entity. It is provided with the
-		* entity itself and a reference to the component of the view.<br/>
+		* The function object is invoked for each entity. It is provided with the entity
+		* identifier (known to be valid, see `EntityManager::get`) and a reference to
+		* the component of the view.<br/>
 		* The signature of the function should be equivalent to the following:
 		*
 		* @code{.cpp}
-		* void(cs::Entity, Component&);
+		* void(EntityId, Component&);
 		* @endcode
 		*
 		* @tparam Function Type of the function object to invoke.
 		* @param function A intersects function object.
 		*/
 		template <typename Function>
-		void each(Function& function) {
+		void each(Function function) {
 			for (auto id : components) {
-				function(Entity(manager, id), components.get(id));
+				function(id, components.get(id));
 			}
 		}
 
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include "../../Entity/Entity.h"
+#include "../../Profile/Profiler.h"
+
+namespace cs
+{
+	/**
+	* @brief Resumable iteration of a view, spread over several calls.
+	*
+	* Each call to `each` processes the entities of the given view up to a
+	* budget (either a number of entities or a duration), then stops and
+	* remembers where it was. The next call resumes from there, usually with a
+	* new view of the same types the next frame.<br/>
+	* Entities are walked by index (version excluded) rather than by position
+	* within the packed arrays, thus the cursor is unaffected by insertions,
+	* removals and sorting in between: within a pass, every index is visited
+	* once at most. Entities created behind the cursor wait for the next pass,
+	* removed ones are never visited.
+	*
+	* @note
+	* Empty indices aren't charged to the budget of entities, a duration is the
+	* safest bound for sparse sets.
+	*/
+	class ViewCursor final
+	{
+	public:
+		/**
+		* @brief Processes up to `budget` entities of a view.
+		*
+		* The signature of the function is the same as for `each` of the view.
+		*
+		* @return True if the pass has been completed, in which case the cursor
+		* is rewound.
+		*/
+		template <typename View, typename Function>
+		bool each(const View& view, std::uint32_t budget, Function function) {
+			return walk(view, function, [&budget](std::uint32_t processed) { return processed < budget; });
+		}
+
+		/**
+		* @brief Processes the entities of a view until a time budget runs out.
+		*
+		* The clock is read every few entities, so the budget can be overrun by
+		* a few invocations of the function.
+		*
+		* @return True if the pass has been completed, in which case the cursor
+		* is rewound.
+		*/
+		template <typename View, typename Function, typename Rep, typename Period>
+		bool each(const View& view, std::chrono::duration<Rep, Period> budget, Function function) {
+			const auto deadline = std::chrono::steady_clock::now() + budget;
+
+			return walk(view, function, [&deadline](std::uint32_t processed) {
+				return processed % 32U || std::chrono::steady_clock::now() < deadline;
+			});
+		}
+
+		/**
+		* @brief Restarts the pass from the first entity.
+		*/
+		void rewind() {
+			next = 0U;
+		}
+
+		/**
+		* @brief Returns the index (version excluded) the next call resumes from.
+		*/
+		std::uint32_t position() const {
+			return next;
+		}
+
+	private:
+		template <typename View, typename Function, typename Proceed>
+		bool walk(const View& view, Function& function, Proceed proceed) {
+			CS_PROFILE_SCOPE("ViewCursor::each");
+			auto processed = std::uint32_t(0);
+
+			for (const auto last = view.span(); next < last; ++next) {
+				const auto id = view.find(next);
+
+				if (id != Entity::INVALID) {
+					if (!proceed(processed)) {
+						CS_PROFILE_COUNT(processed);
+						return false;
+					}
+
+					view.apply(id, function);
+					++processed;
+				}
+			}
+
+			CS_PROFILE_COUNT(processed);
+			next = 0U;
+
+			return true;
+		}
+
+	private:
+		std::uint32_t next = 0U;
+	};
+}
@@ -1,6 +1,8 @@
 #ifndef CORE_ENTITY_ENTITY_H
 #define CORE_ENTITY_ENTITY_H
 
+#include "EntityTraits.h"
+
 namespace cs
 {
 	class EntityManager;
@@ -8,39 +10,49 @@ namespace cs
 	class Entity final
 	{
 	public:
-		static const int ID_MASK = 0xFFFFFF;
-		static const int VERSION_MASK = 0xFF;
-		static const int VERSION_SHIFT = 24;
+		static const EntityId ID_MASK = EntityTraits::ID_MASK;
+		static const EntityId VERSION_MASK = EntityTraits::VERSION_MASK;
+		static const EntityId VERSION_SHIFT = EntityTraits::VERSION_SHIFT;
+		static const EntityId INVALID = ~EntityId(0); // Never handed out by a manager
 
 		Entity() = default;
 		Entity(const Entity&) = default;
-		explicit Entity(EntityManager* manager, std::uint32_t id);
+		explicit Entity(EntityManager* manager, EntityId id);
 
 		Entity& operator=(const Entity&) = default;
 		
 		void destroy();
 		bool valid() const;
 
-		const std::uint32_t id() const;
-		const std::uint32_t version() const;
+		const EntityId id() const;
+		const EntityId version() const;
 
 		template <typename Component, typename... Args>
-		Component assign(Args&&... args);
+		Component& assign(Args&&... args);
 
 		template <typename Component, typename... Args>
-		Component replace(Args&&... args);
+		Component& replace(Args&&... args);
 
 		template <typename Component, typename... Args>
-		Component accomodate(Args&&... args);
+		Component& accomodate(Args&&... args);
 
-		template <typename Component, typename... Components>
-		void assign(const Component& component, const Components&... components);
+		template <typename Component>
+		std::decay_t<Component>& assign(Component&& component);
 
-		template <typename Component, typename... Components>
-		void replace(const Component& component, const Components&... components);
+		template <typename Component>
+		std::decay_t<Component>& replace(Component&& component);
 
-		template <typename Component, typename... Components>
-		void accomodate(const Component& component, const Components&... components);
+		template <typename Component>
+		std::decay_t<Component>& accomodate(Component&& component);
+
+		template <typename Component, typename Other, typename... Components>
+		void assign(Component&& component, Other&& other, Components&&... components);
+
+		template <typename Component, typename Other, typename... Components>
+		void replace(Component&& component, Other&& other, Components&&... components);
+
+		template <typename Component, typename Other, typename... Components>
+		void accomodate(Component&& component, Other&& other, Components&&... components);
 
 		template <typename Component, typename... Components>
 		void reset();
@@ -54,6 +66,10 @@ namespace cs
 		template <typename Component, typename... Components>
 		void remove(const Component& component, const Components&... components);
 
+		void attach(const Entity& parent);
+		void detach();
+		Entity parent() const;
+
 		template <typename Component, typename... Components>
 		bool has() const;
 
@@ -79,7 +95,7 @@ namespace cs
 		operator bool() const;
 
 	private:
-		std::uint32_t identifier;
+		EntityId identifier;
 		cs::EntityManager* manager;
 	};
 }
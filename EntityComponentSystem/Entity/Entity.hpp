@@ -6,7 +6,12 @@
 
 namespace cs
 {
-	Entity::Entity(EntityManager* manager, std::uint32_t id)
+	const EntityId Entity::ID_MASK;
+	const EntityId Entity::VERSION_MASK;
+	const EntityId Entity::VERSION_SHIFT;
+	const EntityId Entity::INVALID;
+
+	Entity::Entity(EntityManager* manager, EntityId id)
 		: manager(manager)
 		, identifier(id)
 	{}
@@ -14,15 +19,16 @@ namespace cs
 	/**
 	* @brief Assigns the given component to this entity.
 	*
-	* A new instance of the given component is created and initialized with the
-	* arguments provided (the component must have a proper constructor or be of
-	* aggregate type). Then the component is assigned to the given entity.
+	* A new instance of the given component is constructed in place from the
+	* arguments provided (the component must have a proper constructor), directly
+	* into the storage of the component type. No temporary is copied around, thus
+	* move-only components are supported as well.
 	*
 	* @warning
-	* Attempting to use an invalid entity or to assign a component to an entity
-	* that already owns it results in undefined behavior.<br/>
+	* Attempting to use an invalid entity results in undefined behavior.<br/>
 	* An assertion will abort the execution at runtime in debug mode in case of
-	* invalid entity or if the entity already owns an instance of the given component.
+	* invalid entity. Assigning a component to an entity that already owns it
+	* throws `std::runtime_error`.
 	*
 	* @tparam Component Type of component to create.
 	* @tparam Args Types of arguments to use to construct the component.
@@ -30,22 +36,44 @@ namespace cs
 	* @return A reference to the newly created component.
 	*/
 	template <typename Component, typename... Args>
-	Component Entity::assign(Args&&... args) {
+	Component& Entity::assign(Args&&... args) {
 		return manager->assign<Component>(identifier, std::forward<Args>(args)...);
 	}
 
+	/**
+	* @brief Assigns the given component to this entity.
+	*
+	* The component is either copied or moved into its storage, depending on the
+	* value category of the argument.
+	*
+	* @warning
+	* Attempting to use an invalid entity results in undefined behavior.<br/>
+	* An assertion will abort the execution at runtime in debug mode in case of
+	* invalid entity. Assigning a component to an entity that already owns it
+	* throws `std::runtime_error`.
+	*
+	* @return A reference to the newly assigned component.
+	*/
+	template <typename Component>
+	std::decay_t<Component>& Entity::assign(Component&& component) {
+		return manager->assign(identifier, std::forward<Component>(component));
+	}
+
 	/**
 	* @brief Assigns the given components to this entity.
 	*
+	* Components are either copied or moved into their storage, depending on the
+	* value category of the arguments.
+	*
 	* @warning
-	* Attempting to use an invalid entity or to assign a component to an entity
-	* that already owns it results in undefined behavior.<br/>
+	* Attempting to use an invalid entity results in undefined behavior.<br/>
 	* An assertion will abort the execution at runtime in debug mode in case of
-	* invalid entity or if the entity already owns an instance of the given component.
+	* invalid entity. Assigning a component to an entity that already owns it
+	* throws `std::runtime_error`.
 	*/
-	template <typename Component, typename... Components>
-	void Entity::assign(const Component& component, const Components&... components) {
-		manager->assign(identifier, component, components...);
+	template <typename Component, typename Other, typename... Components>
+	void Entity::assign(Component&& component, Other&& other, Components&&... components) {
+		manager->assign(identifier, std::forward<Component>(component), std::forward<Other>(other), std::forward<Components>(components)...);
 	}
 
 	/**
@@ -56,10 +84,10 @@ namespace cs
 	* aggregate type). Then the component is assigned to this entity.
 	*
 	* @warning
-	* Attempting to use an invalid entity or to replace a component of an
-	* entity that doesn't own it results in undefined behavior.<br/>
+	* Attempting to use an invalid entity results in undefined behavior.<br/>
 	* An assertion will abort the execution at runtime in debug mode in case of
-	* invalid entity or if the entity doesn't own an instance of the given component.
+	* invalid entity. Replacing a component of an entity that doesn't own it
+	* throws `std::runtime_error`.
 	*
 	* @tparam Component Type of component to replace.
 	* @tparam Args Types of arguments to use to construct the component.
@@ -67,22 +95,38 @@ namespace cs
 	* @return A reference to the newly created component.
 	*/
 	template <typename Component, typename... Args>
-	Component Entity::replace(Args&&... args) {
+	Component& Entity::replace(Args&&... args) {
 		return manager->replace<Component>(identifier, std::forward<Args>(args)...);
 	}
 
+	/**
+	* @brief Replaces the given component.
+	*
+	* @warning
+	* Attempting to use an invalid entity results in undefined behavior.<br/>
+	* An assertion will abort the execution at runtime in debug mode in case of
+	* invalid entity. Replacing a component of an entity that doesn't own it
+	* throws `std::runtime_error`.
+	*
+	* @return A reference to the replaced component.
+	*/
+	template <typename Component>
+	std::decay_t<Component>& Entity::replace(Component&& component) {
+		return manager->replace(identifier, std::forward<Component>(component));
+	}
+
 	/**
 	* @brief Replaces the given components.
 	*
 	* @warning
-	* Attempting to use an invalid entity or to replace a component of an
-	* entity that doesn't own it results in undefined behavior.<br/>
+	* Attempting to use an invalid entity results in undefined behavior.<br/>
 	* An assertion will abort the execution at runtime in debug mode in case of
-	* invalid entity or if the entity doesn't own an instance of the given component.
+	* invalid entity. Replacing a component of an entity that doesn't own it
+	* throws `std::runtime_error`.
 	*/
-	template <typename Component, typename... Components>
-	void Entity::replace(const Component& component, const Components&... components) {
-		manager->replace(identifier, component, components...);
+	template <typename Component, typename Other, typename... Components>
+	void Entity::replace(Component&& component, Other&& other, Components&&... components) {
+		manager->replace(identifier, std::forward<Component>(component), std::forward<Other>(other), std::forward<Components>(components)...);
 	}
 
 	/**
@@ -100,10 +144,26 @@ namespace cs
 	* @return A reference to the newly created component.
 	*/
 	template <typename Component, typename... Args>
-	Component Entity::accomodate(Args&&... args) {
+	Component& Entity::accomodate(Args&&... args) {
 		return manager->accomodate<Component>(identifier, std::forward<Args>(args)...);
 	}
 
+	/**
+	* @brief Assigns or replaces the given component for this entity.
+	* Prefer this function anyway because it has slighlty better performance.
+	*
+	* @warning
+	* Attempting to use an invalid entity results in undefined behavior.<br/>
+	* An assertion will abort the execution at runtime in debug mode in case of
+	* invalid entity.
+	*
+	* @return A reference to the assigned or replaced component.
+	*/
+	template <typename Component>
+	std::decay_t<Component>& Entity::accomodate(Component&& component) {
+		return manager->accomodate(identifier, std::forward<Component>(component));
+	}
+
 	/**
 	* @brief Assigns or replaces the given components for this entity.
 	* Prefer this function anyway because it has slighlty better performance.
@@ -113,9 +173,9 @@ namespace cs
 	* An assertion will abort the execution at runtime in debug mode in case of
 	* invalid entity.
 	*/
-	template <typename Component, typename... Components>
-	void Entity::accomodate(const Component& component, const Components&... components) {
-		manager->accomodate(identifier, component, components...);
+	template <typename Component, typename Other, typename... Components>
+	void Entity::accomodate(Component&& component, Other&& other, Components&&... components) {
+		manager->accomodate(identifier, std::forward<Component>(component), std::forward<Other>(other), std::forward<Components>(components)...);
 	}
 
 	/**
@@ -150,7 +210,7 @@ namespace cs
 	/**
 	* @brief Returns the entity identifier.
 	*/
-	const std::uint32_t Entity::id() const {
+	const EntityId Entity::id() const {
 		return identifier;
 	}
 
@@ -166,7 +226,7 @@ namespace cs
 	*
 	* @return Actual version for this entity.
 	*/
-	const std::uint32_t Entity::version() const {
+	const EntityId Entity::version() const {
 		return manager->current(identifier);
 	}
 
@@ -199,6 +259,46 @@ namespace cs
 		manager->destroy(identifier);
 	}
 
+	/**
+	* @brief Makes this entity a child of the given entity.
+	*
+	* The subtree rooted at this entity is moved along with it, so that the
+	* hierarchy of the manager stays packed in depth-first order.
+	*
+	* @warning
+	* Attempting to use invalid entities or to attach an entity to one of its own
+	* descendants results in undefined behavior.<br/>
+	* An assertion will abort the execution at runtime in debug mode in case of
+	* cycles.
+	*
+	* @param parent The new parent of this entity.
+	*/
+	void Entity::attach(const Entity& parent) {
+		manager->attach(identifier, parent.identifier);
+	}
+
+	/**
+	* @brief Detaches this entity from its parent, making it a root.
+	*
+	* @warning
+	* Attempting to use an invalid entity results in undefined behavior.
+	*/
+	void Entity::detach() {
+		manager->detach(identifier);
+	}
+
+	/**
+	* @brief Returns the parent of this entity.
+	*
+	* @warning
+	* Attempting to use an invalid entity results in undefined behavior.
+	*
+	* @return The parent entity, an invalid one if this entity is a root.
+	*/
+	Entity Entity::parent() const {
+		return Entity(manager, manager->parent(identifier));
+	}
+
 	/**
 	* @brief Returns a reference to the given component for this entity.
 	*
@@ -8,17 +8,44 @@
 #include <cstddef>
 #include <cstdint>
 #include <cassert>
+#include <thread>
 #include <algorithm>
+#include <initializer_list>
+#include <exception>
+#include <stdexcept>
 #include <type_traits>
 #include "../Type/Family.h"
 #include "../Entity/Entity.h"
 #include "../Component/Container/ComponentCollection.h"
+#include "../Component/Container/Hierarchy.h"
+#include "../Component/Container/SharedCollection.h"
+#include "../Component/Container/RuntimeCollection.h"
 #include "../Component/View/View.h"
 #include "../Component/View/PersistentView.h"
 #include "../Component/View/ComponentView.h"
+#include "../Component/View/RuntimeView.h"
+#include "../Component/View/ViewCursor.h"
+#include "../Event/EventChannel.h"
+#include "../Profile/Profiler.h"
 
 namespace cs
 {
+	class Prefab;
+	class ChangeLog;
+	class Rollback;
+	class Spawner;
+
+	/**
+	* @brief Entity manager.
+	*
+	* Identifiers received by the member functions are validated against the
+	* entities currently alive and `std::runtime_error` is thrown on mismatch.
+	* Define `CS_UNCHECKED` to compile the validation down to an assertion
+	* (thus removed along with `NDEBUG`) in builds that don't need it.<br/>
+	* Hot loops that already know their identifiers are alive (as an example,
+	* the ones received by the callbacks of views) can use `get` instead of
+	* `component`, which is never validated.
+	*/
 	class EntityManager
 	{
 	public:
@@ -35,49 +62,61 @@ namespace cs
 		Entity create(Args&&... args);
 
 		template <typename Component, typename... Components>
-		Entity create(const Component& component, const Components&... components);
+		Entity create(Component&& component, Components&&... components);
 
 		template <typename Component, typename... Args>
-		Component assign(std::uint32_t id, Args&&... args);
+		Component& assign(EntityId id, Args&&... args);
 
 		template <typename Component, typename... Args>
-		Component replace(std::uint32_t id, Args&&... args);
+		Component& replace(EntityId id, Args&&... args);
 
 		template <typename Component, typename... Args>
-		Component accomodate(std::uint32_t id, Args&&... args);
+		Component& accomodate(EntityId id, Args&&... args);
 
-		template <typename Component, typename... Components>
-		void assign(std::uint32_t id, const Component& component, const Components&... components);
+		template <typename Component>
+		std::decay_t<Component>& assign(EntityId id, Component&& component);
 
-		template <typename Component, typename... Components>
-		void replace(std::uint32_t id, const Component& component, const Components&... components);
+		template <typename Component>
+		std::decay_t<Component>& replace(EntityId id, Component&& component);
 
-		template <typename Component, typename... Components>
-		void accomodate(std::uint32_t id, const Component& component, const Components&... components);
+		template <typename Component>
+		std::decay_t<Component>& accomodate(EntityId id, Component&& component);
+
+		template <typename Component, typename Other, typename... Components>
+		void assign(EntityId id, Component&& component, Other&& other, Components&&... components);
+
+		template <typename Component, typename Other, typename... Components>
+		void replace(EntityId id, Component&& component, Other&& other, Components&&... components);
+
+		template <typename Component, typename Other, typename... Components>
+		void accomodate(EntityId id, Component&& component, Other&& other, Components&&... components);
 
 		template <typename Component, typename... Components>
-		void reset(std::uint32_t id);
+		void reset(EntityId id);
 
 		template <typename Component, typename... Components>
-		void reset(std::uint32_t id, const Component& unused, const Components&... unuseds);
+		void reset(EntityId id, const Component& unused, const Components&... unuseds);
 
 		template <typename Component, typename... Components>
-		void remove(std::uint32_t id);
+		void remove(EntityId id);
 
 		template <typename Component, typename... Components>
-		void remove(std::uint32_t id, const Component& unused, const Components&... unuseds);
+		void remove(EntityId id, const Component& unused, const Components&... unuseds);
 
 		template <typename Component, typename... Components>
-		bool has(std::uint32_t id);
+		bool has(EntityId id);
 
 		template <typename Component, typename... Components>
-		bool has(std::uint32_t id, const Component& unused, const Components&... unuseds);
+		bool has(EntityId id, const Component& unused, const Components&... unuseds);
 
 		template <typename Component>
-		Component& component(std::uint32_t id);
+		Component& component(EntityId id);
+
+		template <typename Component>
+		Component& get(EntityId id);
 
 		template <typename... Components>
-		std::tuple<Components&...> components(std::uint32_t id);
+		std::tuple<Components&...> components(EntityId id);
 
 		template <typename Component>
 		std::uint32_t count();
@@ -87,17 +126,22 @@ namespace cs
 		template <typename Component>
 		void reserve(std::uint32_t capacity);
 		void reserve(std::uint32_t capacity);
+		void shrink_to_fit();
+
+		template <typename Component>
+		Footprint footprint() const;
+		Footprint footprint() const;
 
 		template <typename Component, typename... Components>
 		bool empty();
 		bool empty() const;
 		
-		std::uint32_t version(std::uint32_t id) const;
-		std::uint32_t current(std::uint32_t id) const;
+		EntityId version(EntityId id) const;
+		EntityId current(EntityId id) const;
 
-		void destroy(std::uint32_t id);
-		bool valid(std::uint32_t id) const;
-		void validate(std::uint32_t id) const;
+		void destroy(EntityId id);
+		bool valid(EntityId id) const;
+		void validate(EntityId id) const;
 
 		template <typename Component, typename Compare>
 		void sort(Compare compare);
@@ -109,14 +153,96 @@ namespace cs
 		void reset();
 		void reset();
 
+		template <typename Component>
+		void stabilize(bool enabled = true);
+
+		template <typename Component, typename... Components>
+		void compact();
+		void compact();
+
+		template <typename Component>
+		void tier(std::uint32_t period, bool compressed = true);
+
+		template <typename Component, typename... Components>
+		std::uint32_t freeze();
+
+		template <typename Component>
+		void buffer(bool enabled = true);
+
+		template <typename Component>
+		const ComponentCollection<Component>& front() const;
+
+		template <typename Component>
+		const ComponentCollection<Component>* peek() const;
+
+		template <typename Component, typename... Components>
+		void swap();
+		void swap();
+
+		void record(ChangeLog* log);
+
+		template <typename Component>
+		void track(std::uint32_t tag);
+
+		template <typename Component, typename... Components>
+		void modify();
+
+		template <typename Event>
+		EventChannel<Event>& channel();
+		void flush();
+
+		void define(const ComponentType& type);
+		RuntimeCollection& column(std::uint32_t type);
+		void* emplace(EntityId id, std::uint32_t type, const void* component = nullptr);
+		void erase(EntityId id, std::uint32_t type);
+		bool contains(EntityId id, std::uint32_t type);
+		void* component(EntityId id, std::uint32_t type);
+		RuntimeView view(std::initializer_list<std::uint32_t> types);
+
+		EntityManager fork() const;
+		std::vector<EntityId> merge(EntityManager&& other);
+
+		template <typename Iterator>
+		std::vector<EntityId> migrate(Iterator first, Iterator last, EntityManager& destination);
+
+		Prefab capture(EntityId id) const;
+		std::vector<EntityId> instantiate(EntityId prototype, std::uint32_t count);
+		std::vector<EntityId> instantiate(const Prefab& prefab, std::uint32_t count);
+
+		void attach(EntityId child, EntityId parent);
+		void detach(EntityId child);
+		EntityId parent(EntityId id) const;
+		const Hierarchy& hierarchy() const;
+
+		template <typename Component, typename... Components>
+		void arrange();
+
+		template <typename Function>
+		void traverse(Function function) const;
+
+		template <typename Component>
+		void observe(ComponentListener<Component>& listener);
+
+		template <typename Component>
+		void unobserve(ComponentListener<Component>& listener);
+
+		template <typename Component, typename... Components>
+		ComponentView<Component, Components...> view();
+
 		template <typename Function>
-		void each(Function& function);
+		void each(Function function);
 
 		template <typename Component, typename... Components, typename Function>
-		void each(Function& function);
+		void each(Function function);
 
 		template <typename Component, typename... Components, typename Function>
-		void every(Function& function);
+		void every(Function function);
+
+		template <typename Component, typename... Components, typename Type, typename Map, typename Combine>
+		Type reduce(Type init, Map map, Combine combine);
+
+		template <typename Component, typename Function>
+		void group(Function function);
 
 	protected:
 		template <typename Component>
@@ -130,47 +256,78 @@ namespace cs
 
 		template <typename Component>
 		ComponentCollection<Component>& ensure();
+		Collection& ensure(std::uint32_t uid, const Collection& prototype);
+
+		template <typename Component>
+		ComponentCollection<Component>& write();
+
+	private:
+		friend class Rollback;
+		friend class Spawner;
+
+		Collection* lookup(std::uint32_t uid) const;
+		Collection* own(std::uint32_t uid);
+		EntityId generate();
+		void release(EntityId id);
+		void clear(std::uint32_t uid);
+		std::vector<EntityId> replicate(const EntityManager& source, EntityId prototype, std::uint32_t count);
 
 	private:
 		#pragma region Fallbacks
 		
 		// Fallback blank function for recursion
-		void assign(std::uint32_t id) {}
+		template <bool expand = true>
+		void reset() {}
 
 		// Fallback blank function for recursion
-		void replace(std::uint32_t id) {}
+		template <bool expand = true>
+		void remove(EntityId id) {}
 
 		// Fallback blank function for recursion
-		void accomodate(std::uint32_t id) {}
+		template <bool expand = true>
+		void reset(EntityId id) {}
 
 		// Fallback blank function for recursion
 		template <bool expand = true>
-		void reset() {}
+		bool has(EntityId id) { return true; }
 
 		// Fallback blank function for recursion
 		template <bool expand = true>
-		void remove(std::uint32_t id) {}
+		bool empty() const { return false; }
 
 		// Fallback blank function for recursion
 		template <bool expand = true>
-		void reset(std::uint32_t id) {}
+		void arrange() {}
 
 		// Fallback blank function for recursion
 		template <bool expand = true>
-		bool has(std::uint32_t id) { return true; }
+		void compact() {}
 
 		// Fallback blank function for recursion
 		template <bool expand = true>
-		bool empty() const { return false; }
+		std::uint32_t freeze() { return 0U; }
+
+		// Fallback blank function for recursion
+		template <bool expand = true>
+		void swap() {}
+
+		// Fallback blank function for recursion
+		template <bool expand = true>
+		void modify() {}
 
 		#pragma endregion
 
 	private:
-		std::uint32_t next = 0U;
+		EntityId next = 0U;
 		std::uint32_t available = 0U;
-		std::vector<std::uint32_t> entities;
+		std::uint32_t reserved = 0U; // Slots claimed by a Spawner and not committed yet
+		ChangeLog* log = nullptr;
+		const EntityManager* base = nullptr; // Manager this one has been forked from, see fork
+		std::vector<EntityId> entities;
+		Hierarchy tree;
 		std::vector<std::unique_ptr<Collection>> sets;
 		std::vector<std::unique_ptr<Collection>> handlers;
+		std::vector<std::unique_ptr<Channel>> channels;
 	};
 }
 
@@ -3,59 +3,82 @@
 
 #include "EntityManager.h"
 #include "Entity.h"
+#include "Prefab.hpp"
+#include "../Replication/ChangeLog.hpp"
+#include "../Event/EventChannel.hpp"
+#include "../Component/Container/Hierarchy.hpp"
+#include "../Component/Container/SharedCollection.hpp"
+#include "../Component/Container/RuntimeCollection.hpp"
+#include "../Profile/Profiler.hpp"
 
 namespace cs
 {
 	template <typename Component, typename... Args>
-	Component EntityManager::assign(std::uint32_t id, Args&&... args) {
+	Component& EntityManager::assign(EntityId id, Args&&... args) {
 		validate(id);
-		auto component = Component(std::forward<Args>(args)...);
-		ensure<Component>().add(id, component);
-		return component;
+		return ensure<Component>().emplace(id, std::forward<Args>(args)...);
 	}
 
 	template <typename Component, typename... Args>
-	Component EntityManager::replace(std::uint32_t id, Args&&... args) {
+	Component& EntityManager::replace(EntityId id, Args&&... args) {
 		validate(id);
-		auto component = Component(std::forward<Args>(args)...);
-		set<Component>().update(id, component);
-		return component;
+		return ensure<Component>().replace(id, std::forward<Args>(args)...);
 	}
 
 	template <typename Component, typename... Args>
-	Component EntityManager::accomodate(std::uint32_t id, Args&&... args) {
+	Component& EntityManager::accomodate(EntityId id, Args&&... args) {
 		validate(id);
-		auto component = Component(std::forward<Args>(args)...);
-		ensure<Component>().accomodate(id, component);
-		return component;
+		auto& cet = ensure<Component>();
+		cet.touch(id);
+		return cet.contains(id) ? cet.replace(id, std::forward<Args>(args)...) : cet.emplace(id, std::forward<Args>(args)...);
 	}
 
-	template <typename Component, typename... Components>
-	void EntityManager::assign(std::uint32_t id, const Component& component, const Components&... components) {
+	template <typename Component>
+	std::decay_t<Component>& EntityManager::assign(EntityId id, Component&& component) {
 		validate(id);
-		ensure<Component>().add(id, component);
-		assign(id, components...);
+		return ensure<std::decay_t<Component>>().emplace(id, std::forward<Component>(component));
 	}
 
-	template <typename Component, typename... Components>
-	void EntityManager::replace(std::uint32_t id, const Component& component, const Components&... components) {
+	template <typename Component>
+	std::decay_t<Component>& EntityManager::replace(EntityId id, Component&& component) {
 		validate(id);
-		ensure<Component>().update(id, component);
-		replace(id, components...);
+		return ensure<std::decay_t<Component>>().replace(id, std::forward<Component>(component));
 	}
 
-	template <typename Component, typename... Components>
-	void EntityManager::accomodate(std::uint32_t id, const Component& component, const Components&... components) {
+	template <typename Component>
+	std::decay_t<Component>& EntityManager::accomodate(EntityId id, Component&& component) {
 		validate(id);
-		ensure<Component>().accomodate(id, component);
-		accomodate(id, components...);
+		auto& cet = ensure<std::decay_t<Component>>();
+		cet.touch(id);
+		return cet.contains(id) ? cet.replace(id, std::forward<Component>(component)) : cet.emplace(id, std::forward<Component>(component));
+	}
+
+	template <typename Component, typename Other, typename... Components>
+	void EntityManager::assign(EntityId id, Component&& component, Other&& other, Components&&... components) {
+		assign(id, std::forward<Component>(component));
+		assign(id, std::forward<Other>(other), std::forward<Components>(components)...);
+	}
+
+	template <typename Component, typename Other, typename... Components>
+	void EntityManager::replace(EntityId id, Component&& component, Other&& other, Components&&... components) {
+		replace(id, std::forward<Component>(component));
+		replace(id, std::forward<Other>(other), std::forward<Components>(components)...);
+	}
+
+	template <typename Component, typename Other, typename... Components>
+	void EntityManager::accomodate(EntityId id, Component&& component, Other&& other, Components&&... components) {
+		accomodate(id, std::forward<Component>(component));
+		accomodate(id, std::forward<Other>(other), std::forward<Components>(components)...);
 	}
 
 	template <typename Component, typename... Components>
-	void EntityManager::reset(std::uint32_t id) {
+	void EntityManager::reset(EntityId id) {
 		validate(id);
 
-		if (managed<Component>()) {
+		// Forks don't copy the sets that haven't the component
+		const auto cet = peek<Component>();
+
+		if (cet && (cet->contains(id) || cet->frozen(id))) {
 			set<Component>().reset(id);
 		}
 
@@ -63,35 +86,48 @@ namespace cs
 	}
 
 	template <typename Component, typename... Components>
-	void EntityManager::reset(std::uint32_t id, const Component& unused, const Components&... unuseds) {
+	void EntityManager::reset(EntityId id, const Component& unused, const Components&... unuseds) {
 		reset<Component, Components...>(id);
 	}
 
 	template <typename Component, typename... Components>
-	void EntityManager::remove(std::uint32_t id) {
+	void EntityManager::remove(EntityId id) {
 		validate(id);
 		set<Component>().remove(id);
 		remove<Components...>(id);
 	}
 
 	template <typename Component, typename... Components>
-	void EntityManager::remove(std::uint32_t id, const Component& unused, const Components&... unuseds) {
+	void EntityManager::remove(EntityId id, const Component& unused, const Components&... unuseds) {
 		remove<Component, Components...>(id);
 	}
 
 	template <typename Component, typename... Components>
-	bool EntityManager::has(std::uint32_t id) {
+	bool EntityManager::has(EntityId id) {
 		validate(id);
-		return managed<Component>() && set<Component>().contains(id) && has<Components...>(id);
+		const auto cet = peek<Component>();
+		return cet && (cet->contains(id) || cet->frozen(id)) && has<Components...>(id);
 	}
 
 	template <typename Component, typename... Components>
-	bool EntityManager::has(std::uint32_t id, const Component& unused, const Components&... unuseds) {
+	bool EntityManager::has(EntityId id, const Component& unused, const Components&... unuseds) {
 		return has<Component, Components...>(id);
 	}
 
+	/**
+	* @brief Creates an entity without components.
+	*
+	* Not thread safe, as the other member functions: see Spawner to create
+	* entities from several threads at once.
+	*/
 	Entity EntityManager::create() {
-		std::uint32_t id;
+		CS_PROFILE_SCOPE("EntityManager::create");
+		CS_PROFILE_COUNT(1);
+		return Entity(this, generate());
+	}
+
+	EntityId EntityManager::generate() {
+		EntityId id;
 
 		if (available) {
 			const auto entity = next;
@@ -103,46 +139,64 @@ namespace cs
 			--available;
 		}
 		else {
-			id = std::uint32_t(entities.size());
-			assert(id < Entity::ID_MASK);
+			// The highest entity is left out, the whole mask is part of Entity::INVALID
+			if (entities.size() >= Entity::ID_MASK) {
+				throw std::runtime_error("Out of entities");
+			}
+
+			id = EntityId(entities.size());
 			entities.push_back(id);
 		}
 
-		return Entity(this, id);
+		if (log) {
+			log->created(id);
+		}
+
+		return id;
 	}
 
 	template <typename Component, typename... Components>
-	Entity EntityManager::create(const Component& component, const Components&... components) {
+	Entity EntityManager::create(Component&& component, Components&&... components) {
 		auto entity = create();
-		entity.assign(component, components...);
+		entity.assign(std::forward<Component>(component), std::forward<Components>(components)...);
 		return entity;
 	}
 
 	template <typename Component, typename... Args>
 	Entity EntityManager::create(Args&&... args) {
 		auto entity = create();
-		entity.assign<Component>(args...);
+		entity.assign<Component>(std::forward<Args>(args)...);
 		return entity;
 	}
 
 	template <typename Component>
-	Component& EntityManager::component(std::uint32_t id) {
+	Component& EntityManager::component(EntityId id) {
 		validate(id);
+		auto& cet = set<Component>();
+		cet.touch(id);
+		cet.modify();
+		return cet.get(id);
+	}
+
+	template <typename Component>
+	Component& EntityManager::get(EntityId id) {
+		assert(valid(id) && set<Component>().contains(id));
 		return set<Component>().get(id);
 	}
 
 	template <typename... Components>
-	std::tuple<Components&...> EntityManager::components(std::uint32_t id) {
+	std::tuple<Components&...> EntityManager::components(EntityId id) {
 		return std::tuple<Components&...>(component<Components>(id)...);
 	}
 
 	template <typename Component>
 	std::uint32_t EntityManager::count() {
-		return managed<Component>() ? set<Component>().size() : std::uint32_t();
+		const auto cet = peek<Component>();
+		return cet ? cet->size() - cet->tombstones() + cet->frozen() : std::uint32_t();
 	}
 
 	std::uint32_t EntityManager::size() const {
-		return entities.size() - available;
+		return entities.size() - available - reserved;
 	}
 
 	std::uint32_t EntityManager::capacity() const {
@@ -158,61 +212,130 @@ namespace cs
 		entities.reserve(capacity);
 	}
 
+	void EntityManager::shrink_to_fit() {
+		CS_PROFILE_SCOPE("EntityManager::shrink_to_fit");
+
+		// Slots of destroyed entities carry the versions of stale identifiers, only the capacity goes
+		entities.shrink_to_fit();
+		tree.shrink_to_fit();
+
+		for (auto&& cet : sets) {
+			if (cet) {
+				cet->shrink_to_fit();
+			}
+		}
+	}
+
+	template <typename Component>
+	Footprint EntityManager::footprint() const {
+		const auto uid = ComponentFamily::uid<Component>();
+		return uid < sets.size() && sets[uid] ? sets[uid]->footprint() : Footprint();
+	}
+
+	Footprint EntityManager::footprint() const {
+		Footprint footprint;
+
+		footprint.dense = entities.size() * sizeof(EntityId);
+		footprint.slack = (entities.capacity() - entities.size()) * sizeof(EntityId);
+		footprint.available = available;
+		footprint += tree.footprint();
+
+		for (auto&& cet : sets) {
+			if (cet) {
+				footprint += cet->footprint();
+			}
+		}
+
+		for (auto&& handler : handlers) {
+			if (handler) {
+				footprint += handler->footprint();
+			}
+		}
+
+		return footprint;
+	}
+
 	template <typename Component, typename... Components>
 	bool EntityManager::empty() {
-		return managed<Component>() ? (set<Component>().empty() ? true : empty<Components...>()) : true;
+		const auto cet = peek<Component>();
+		return cet ? (cet->empty() ? true : empty<Components...>()) : true;
 	}
 
 	bool EntityManager::empty() const {
-		return entities.size() == available;
+		return size() == 0U;
 	}
 
-	std::uint32_t EntityManager::version(std::uint32_t id) const {
-		return std::uint32_t((id >> Entity::VERSION_SHIFT) & Entity::VERSION_MASK);
+	EntityId EntityManager::version(EntityId id) const {
+		return (id >> Entity::VERSION_SHIFT) & Entity::VERSION_MASK;
 	}
 
-	std::uint32_t EntityManager::current(std::uint32_t id) const {
+	EntityId EntityManager::current(EntityId id) const {
 		auto index = id & Entity::ID_MASK;
 		assert(index < entities.size());
-		return std::uint32_t((entities[index] >> Entity::VERSION_SHIFT) & Entity::VERSION_MASK);
+		return (entities[index] >> Entity::VERSION_SHIFT) & Entity::VERSION_MASK;
 	}
 
-	void EntityManager::destroy(std::uint32_t id) {
+	void EntityManager::destroy(EntityId id) {
+		CS_PROFILE_SCOPE("EntityManager::destroy");
+		CS_PROFILE_COUNT(1);
 		validate(id);
+		release(id);
+	}
 
+	void EntityManager::release(EntityId id) {
 		const auto entity = id & Entity::ID_MASK;
-		const auto version = (id & (~Entity::ID_MASK)) + (1U << Entity::VERSION_SHIFT);
+		const auto version = (id & (~Entity::ID_MASK)) + (EntityId(1) << Entity::VERSION_SHIFT);
 		const auto node = (available ? next : ((entity + 1U) & Entity::ID_MASK)) | version;
 
 		entities[entity] = node;
 		next = entity;
 		++available;
 
-		for (auto&& cet : sets) {
-			if (cet && cet->contains(id)) {
-				cet->remove(id);
+		for (std::uint32_t uid = 0U; uid < sets.size(); ++uid) {
+			const auto cet = lookup(uid);
+
+			if (cet && (cet->contains(id) || cet->frozen(id))) {
+				own(uid)->remove(id);
 			}
 		}
+
+		tree.remove(id);
+
+		if (log) {
+			log->destroyed(id);
+		}
 	}
 
-	bool EntityManager::valid(std::uint32_t id) const {
+	bool EntityManager::valid(EntityId id) const {
 		auto index = id & Entity::ID_MASK;
 		return (index < entities.size() && entities[index] == id);
 	}
 
-	void EntityManager::validate(std::uint32_t id) const {
+	void EntityManager::validate(EntityId id) const {
+#ifdef CS_UNCHECKED
+		assert(valid(id));
+		static_cast<void>(id); // Unused once assertions are compiled out
+#else
 		if (!valid(id))
-			throw new std::runtime_error("Invalid id");
+			throw std::runtime_error("Invalid id");
+#endif
+	}
+
+	template <typename Component, typename... Components>
+	ComponentView<Component, Components...> EntityManager::view() {
+		return ComponentView<Component, Components...>(this, write<Component>(), write<Components>()...);
 	}
 
 	template <typename Function>
-	void EntityManager::each(Function& function) {
-		if (available) {
-			for (auto id : entities) {
-				const auto clone = id; // Needed?
-				const auto masked = clone & Entity::ID_MASK;
+	void EntityManager::each(Function function) {
+		CS_PROFILE_SCOPE("EntityManager::each");
+		CS_PROFILE_COUNT(size());
+		if (available || reserved) {
+			for (EntityId index = 0U; index < entities.size(); ++index) {
+				const auto id = entities[index];
 
-				if (id == masked) {
+				// Recycled slots link to other slots, alive ones refer to themselves
+				if ((id & Entity::ID_MASK) == index) {
 					function(Entity(this, id));
 				}
 			}
@@ -225,55 +348,681 @@ namespace cs
 	}
 
 	template <typename Component, typename... Components, typename Function>
-	void EntityManager::each(Function& function) {
-		ComponentView<Component, Components...>(this, ensure<Component>(), ensure<Components>()...).each(function);
+	void EntityManager::each(Function function) {
+		ComponentView<Component, Components...>(this, write<Component>(), write<Components>()...).each(function);
 		//View<Component, Components...>(this, ensure<Component>(), ensure<Components>()...).each(function);
 	}
 
+	/**
+	* @brief Combines the components of the entities that have all the given
+	* types, splitting the entities among several threads.
+	*
+	* The map and combine functions must be safe to invoke concurrently and the
+	* initial value must be the identity of the combine function (as an
+	* example, zero for a sum).
+	*/
+	template <typename Component, typename... Components, typename Type, typename Map, typename Combine>
+	Type EntityManager::reduce(Type init, Map map, Combine combine) {
+		CS_PROFILE_SCOPE("EntityManager::reduce");
+
+		const auto grain = std::uint32_t(4096); // Smaller chunks aren't worth a thread
+		const auto view = this->view<Component, Components...>();
+		const auto size = view.candidates();
+		const auto workers = std::max(1U, std::min(std::thread::hardware_concurrency(), (size + grain - 1U) / grain));
+
+		CS_PROFILE_COUNT(size);
+
+		// Each worker writes its own slot, padded so that no two of them share a cache line
+		struct Partial
+		{
+			Type value;
+			std::exception_ptr error;
+			char padding[64];
+		};
+
+		// Threads started are joined even if starting the next ones throws
+		struct Join
+		{
+			std::vector<std::thread>& threads;
+
+			~Join() {
+				for (auto& thread : threads) {
+					thread.join();
+				}
+			}
+		};
+
+		// Init must be the identity of the combine function, it seeds every partial
+		auto partials = std::vector<Partial>(workers, Partial{ init, nullptr, {} });
+		auto threads = std::vector<std::thread>();
+
+		auto chunk = [&](std::uint32_t index) {
+			const auto first = std::uint32_t(std::uint64_t(size) * index / workers);
+			const auto last = std::uint32_t(std::uint64_t(size) * (index + 1U) / workers);
+			auto partial = init; // Accumulated locally, written back once
+
+			auto function = [&partial, &map, &combine](EntityId id, auto&... components) {
+				partial = combine(std::move(partial), map(id, components...));
+			};
+
+			try {
+				view.each(first, last, function);
+				partials[index].value = std::move(partial);
+			}
+			catch (...) {
+				partials[index].error = std::current_exception();
+			}
+		};
+
+		threads.reserve(workers - 1U);
+
+		{
+			Join join{ threads };
+
+			for (auto index = 1U; index < workers; ++index) {
+				threads.emplace_back(chunk, index);
+			}
+
+			chunk(0U);
+		}
+
+		for (const auto& partial : partials) {
+			if (partial.error) {
+				std::rethrow_exception(partial.error);
+			}
+		}
+
+		auto result = std::move(partials.front().value);
+
+		for (auto index = 1U; index < workers; ++index) {
+			result = combine(std::move(result), std::move(partials[index].value));
+		}
+
+		return result;
+	}
+
+	template <typename Component, typename Function>
+	void EntityManager::group(Function function) {
+		CS_PROFILE_SCOPE("EntityManager::group");
+		CS_PROFILE_COUNT(count<Component>());
+		ensure<Component>().group(std::move(function));
+	}
+
 	template <typename Component, typename... Components, typename Function>
-	void EntityManager::every(Function& function) {
+	void EntityManager::every(Function function) {
 		//PersistentView<Components...>(this, handler<Components...>(), set<Components>()...).each(function);
 	}
 
 	template <typename Component, typename Compare>
 	void EntityManager::sort(Compare compare) {
+		CS_PROFILE_SCOPE("EntityManager::sort");
+		CS_PROFILE_COUNT(count<Component>());
 		ensure<Component>().sort(std::move(compare));
 	}
 
 	template <typename To, typename From>
 	void EntityManager::sort() {
+		CS_PROFILE_SCOPE("EntityManager::sort");
+		CS_PROFILE_COUNT(count<To>());
 		ensure<To>().respect(ensure<From>());
 	}
 
+	/**
+	* @brief Clears the sets of the given types as a whole, rather than entity
+	* by entity.
+	*/
 	template <typename Component, typename... Components>
 	void EntityManager::reset() {
+		CS_PROFILE_SCOPE("EntityManager::reset");
+		CS_PROFILE_COUNT(count<Component>());
+		clear(ComponentFamily::uid<Component>());
+		reset<Components...>();
+	}
+
+	/**
+	* @brief Destroys all the entities at once.
+	*
+	* The sets are cleared, then the versions are bumped and the free list is
+	* rebuilt in a single pass (lowest indices are recycled first).
+	*
+	* @warning
+	* Throws `std::runtime_error` while spawns are pending (see Spawner).
+	*/
+	void EntityManager::reset() {
+		CS_PROFILE_SCOPE("EntityManager::reset");
+		CS_PROFILE_COUNT(size());
+
+		if (reserved) {
+			throw std::runtime_error("Spawns are pending");
+		}
+
+		for (std::uint32_t uid = 0U; uid < sets.size(); ++uid) {
+			clear(uid);
+		}
+
+		tree.clear();
+
+		// Every slot goes back to the free list, in order and with a new version if in use
+		for (EntityId index = 0U; index < entities.size(); ++index) {
+			const auto id = entities[index];
+			const auto alive = (id & Entity::ID_MASK) == index;
+			const auto version = (id & (~Entity::ID_MASK)) + (alive ? (EntityId(1) << Entity::VERSION_SHIFT) : EntityId(0));
+
+			if (alive && log) {
+				log->destroyed(id);
+			}
+
+			entities[index] = ((index + 1U) & Entity::ID_MASK) | version;
+		}
+
+		next = 0U;
+		available = std::uint32_t(entities.size());
+	}
+
+	/**
+	* @brief Switches a set to stable removal, or back to swap and pop.
+	*
+	* Stable sets keep the order established by `sort` across removals, they
+	* only shrink when `compact` (or anything that reorders them) is invoked.
+	*/
+	template <typename Component>
+	void EntityManager::stabilize(bool enabled) {
+		ensure<Component>().stabilize(enabled);
+	}
+
+	/**
+	* @brief Sweeps the tombstones of the given sets away, a good candidate is
+	* the end of a frame.
+	*/
+	template <typename Component, typename... Components>
+	void EntityManager::compact() {
 		if (managed<Component>()) {
-			auto& cet = set<Component>();
+			CS_PROFILE_SCOPE("EntityManager::compact");
+			CS_PROFILE_COUNT(set<Component>().tombstones());
+			set<Component>().compact();
+		}
+
+		compact<Components...>();
+	}
+
+	/**
+	* @brief Sweeps the tombstones of all the sets away, hierarchy included.
+	*/
+	void EntityManager::compact() {
+		CS_PROFILE_SCOPE("EntityManager::compact");
+
+		tree.compact();
+
+		for (auto&& cet : sets) {
+			if (cet) {
+				cet->compact();
+			}
+		}
+	}
+
+	/**
+	* @brief Enables the cold tier of a set, or disables it if the period is
+	* zero (see ComponentCollection::tier).
+	*/
+	template <typename Component>
+	void EntityManager::tier(std::uint32_t period, bool compressed) {
+		ensure<Component>().tier(period, compressed);
+	}
 
-			each([&cet](Entity entity) {
-				cet.reset(entity.id());
+	/**
+	* @brief Moves the components that haven't been accessed for a while to the
+	* cold tier of their sets.
+	*
+	* Views bring their sets back and access them as a whole. `component`,
+	* `has`, `count` and the other member functions that receive an identifier
+	* see frozen components as usual, `get` doesn't.
+	*
+	* @return The number of components moved.
+	*/
+	template <typename Component, typename... Components>
+	std::uint32_t EntityManager::freeze() {
+		auto frozen = std::uint32_t(0);
+
+		if (managed<Component>()) {
+			CS_PROFILE_SCOPE("EntityManager::freeze");
+			frozen = set<Component>().freeze();
+			CS_PROFILE_COUNT(frozen);
+		}
+
+		return frozen + freeze<Components...>();
+	}
+
+	/**
+	* @brief Enables double buffering of a set, or disables it.
+	*/
+	template <typename Component>
+	void EntityManager::buffer(bool enabled) {
+		ensure<Component>().buffer(enabled);
+	}
+
+	/**
+	* @brief Returns the front buffer of a set, a copy refreshed by `swap` only
+	* that can be read from other threads.
+	*
+	* @warning
+	* Throws `std::runtime_error` if the set isn't double buffered.
+	*/
+	template <typename Component>
+	const ComponentCollection<Component>& EntityManager::front() const {
+		const auto cet = managed<Component>() ? peek<Component>()->buffered() : nullptr;
+
+		if (!cet) {
+			throw std::runtime_error("Component is not buffered");
+		}
+
+		return *cet;
+	}
+
+	template <typename Component>
+	const ComponentCollection<Component>* EntityManager::peek() const {
+		return static_cast<const ComponentCollection<Component>*>(lookup(ComponentFamily::uid<Component>()));
+	}
+
+	/**
+	* @brief Refreshes the front buffers of the given sets.
+	*
+	* Invoke it at the frame boundary, when no reader is running.
+	*/
+	template <typename Component, typename... Components>
+	void EntityManager::swap() {
+		if (managed<Component>()) {
+			CS_PROFILE_SCOPE("EntityManager::swap");
+			CS_PROFILE_COUNT(set<Component>().size());
+			set<Component>().flip();
+		}
+
+		swap<Components...>();
+	}
+
+	/**
+	* @brief Refreshes the front buffers of all the sets.
+	*/
+	void EntityManager::swap() {
+		CS_PROFILE_SCOPE("EntityManager::swap");
+
+		for (auto&& cet : sets) {
+			if (cet) {
+				cet->flip();
+			}
+		}
+	}
+
+	/**
+	* @brief Attaches a change log, or detaches the current one if null.
+	*
+	* The log records the creation and destruction of entities, along with the
+	* components of the types selected with `track`. Entities alive already are
+	* recorded as created. Detach the log before destroying either side, see
+	* ChangeReplay to apply it elsewhere.
+	*/
+	void EntityManager::record(ChangeLog* log) {
+		if (this->log) {
+			this->log->detach();
+		}
+
+		this->log = log;
+
+		if (log) {
+			each([log](Entity entity) {
+				log->created(entity.id());
 			});
 		}
+	}
 
-		reset<Components...>();
+	/**
+	* @brief Records the components of a type to the attached change log, under
+	* the given tag.
+	*
+	* Components assigned already are recorded as added.
+	*/
+	template <typename Component>
+	void EntityManager::track(std::uint32_t tag) {
+		if (!log) {
+			throw std::runtime_error("No change log attached");
+		}
+
+		auto& cet = ensure<Component>();
+		observe(log->track(cet, tag));
 	}
 
-	void EntityManager::reset() {
-		each([](Entity entity) {
-			entity.destroy();
-		});
+	/**
+	* @brief Flags the given sets as modified (see Collection::revision), which
+	* is how a Rollback tells the sets to snapshot.
+	*
+	* Mutable access (`component`, views, `each`, `reduce`) flags the sets on
+	* its own, `get` doesn't: flag the sets written through it.
+	*/
+	template <typename Component, typename... Components>
+	void EntityManager::modify() {
+		if (managed<Component>()) {
+			set<Component>().modify();
+		}
+
+		modify<Components...>();
+	}
+
+	/**
+	* @brief Returns the channel of a type of events, created on first use.
+	*
+	* Events are carried by channels (see EventChannel) rather than by entities.
+	* Create the channels before publishing from other threads.
+	*/
+	template <typename Event>
+	EventChannel<Event>& EntityManager::channel() {
+		const auto uid = EventFamily::uid<Event>();
+
+		if (uid >= channels.size()) {
+			channels.resize(uid + 1U);
+		}
+
+		if (!channels[uid]) {
+			channels[uid] = std::make_unique<EventChannel<Event>>();
+		}
+
+		return static_cast<EventChannel<Event>&>(*channels[uid]);
+	}
+
+	/**
+	* @brief Makes the events published since the previous flush readable on
+	* every channel, once per frame.
+	*/
+	void EntityManager::flush() {
+		CS_PROFILE_SCOPE("EntityManager::flush");
+
+		for (auto&& channel : channels) {
+			if (channel) {
+				channel->flush();
+			}
+		}
+	}
+
+	/**
+	* @brief Defines a type of component known at runtime only (see
+	* ComponentType).
+	*
+	* Defined types are then handled through their identifiers: `emplace`,
+	* `erase`, `contains`, `component` and `view`.
+	*
+	* @warning
+	* Throws `std::runtime_error` if the alignment of the type isn't a power of
+	* two.
+	*/
+	void EntityManager::define(const ComponentType& type) {
+		if (!type.alignment || (type.alignment & (type.alignment - 1U))) {
+			throw std::runtime_error("Invalid alignment");
+		}
+
+		if (type.id >= sets.size()) {
+			sets.resize(type.id + 1U);
+		}
+
+		if (!own(type.id)) {
+			sets[type.id] = std::make_unique<RuntimeCollection>(type);
+		}
+	}
+
+	RuntimeCollection& EntityManager::column(std::uint32_t type) {
+		const auto cet = type < sets.size() ? dynamic_cast<RuntimeCollection*>(own(type)) : nullptr;
+
+		if (!cet) {
+			throw std::runtime_error("Undefined component");
+		}
+
+		return *cet;
+	}
+
+	void* EntityManager::emplace(EntityId id, std::uint32_t type, const void* component) {
+		validate(id);
+		return column(type).emplace(id, component);
+	}
+
+	void EntityManager::erase(EntityId id, std::uint32_t type) {
+		validate(id);
+		column(type).remove(id);
+	}
+
+	bool EntityManager::contains(EntityId id, std::uint32_t type) {
+		validate(id);
+		const auto cet = lookup(type);
+		return cet && cet->contains(id);
+	}
+
+	void* EntityManager::component(EntityId id, std::uint32_t type) {
+		validate(id);
+		auto& cet = column(type);
+		cet.modify();
+		return cet.get(id);
+	}
+
+	RuntimeView EntityManager::view(std::initializer_list<std::uint32_t> types) {
+		auto columns = std::vector<RuntimeCollection*>();
+
+		for (auto type : types) {
+			columns.push_back(&column(type));
+			columns.back()->modify();
+		}
+
+		return RuntimeView(std::move(columns));
+	}
+
+	/**
+	* @brief Creates a child manager that shares the sets of its parent.
+	*
+	* A set is copied the first time the child writes to it, so that a
+	* speculative simulation costs as much as the sets it changes. Reading
+	* through `has`, `count` and `peek` doesn't copy anything, `component`,
+	* `get` and views do. The parent must outlive its forks and stay untouched
+	* meanwhile.
+	*
+	* @warning
+	* Throws `std::runtime_error` while spawns are pending (see Spawner).
+	*/
+	EntityManager EntityManager::fork() const {
+		CS_PROFILE_SCOPE("EntityManager::fork");
+
+		// Nobody would ever commit the reservations of the child
+		if (reserved) {
+			throw std::runtime_error("Spawns are pending");
+		}
+
+		auto child = EntityManager();
+
+		child.next = next;
+		child.available = available;
+		child.entities = entities;
+		child.tree.mirror(tree);
+		child.sets.resize(sets.size());
+		child.base = this;
+
+		return child;
+	}
+
+	/**
+	* @brief Moves all the entities of another manager into this one.
+	*
+	* The other manager is left empty and detached from its change log, so
+	* that whatever it creates afterwards isn't recorded as part of the old
+	* world.
+	*
+	* @warning
+	* Throws `std::runtime_error` while spawns of the other manager are pending
+	* (see Spawner).
+	*
+	* @return Translation table, indexed by entity of the other manager.
+	*/
+	std::vector<EntityId> EntityManager::merge(EntityManager&& other) {
+		CS_PROFILE_SCOPE("EntityManager::merge");
+		CS_PROFILE_COUNT(other.size());
+
+		// The reservations would point to slots the other manager gives away
+		if (other.reserved) {
+			throw std::runtime_error("Spawns are pending");
+		}
+
+		auto table = std::vector<EntityId>(other.entities.size(), Entity::INVALID);
+
+		entities.reserve(entities.size() + other.size());
+
+		for (EntityId index = 0U; index < other.entities.size(); ++index) {
+			if ((other.entities[index] & Entity::ID_MASK) == index) {
+				table[index] = generate();
+			}
+		}
+
+		for (std::uint32_t uid = 0U; uid < other.sets.size(); ++uid) {
+			if (const auto cet = other.own(uid)) {
+				ensure(uid, *cet).merge(*cet, table);
+			}
+		}
+
+		tree.merge(other.tree, table);
+
+		other.next = other.available = other.reserved = 0U;
+		other.entities.clear();
+		other.handlers.clear();
+		other.log = nullptr;
+
+		return table;
+	}
+
+	/**
+	* @brief Moves entities and their components to another manager.
+	*
+	* @warning
+	* Throws `std::runtime_error` while spawns of the destination are pending
+	* (see Spawner).
+	*
+	* @return Identifiers of the entities in the destination, in order.
+	*/
+	template <typename Iterator>
+	std::vector<EntityId> EntityManager::migrate(Iterator first, Iterator last, EntityManager& destination) {
+		static_assert(!std::is_same<std::decay_t<decltype(*first)>, Entity>::value, "Iterators must refer to identifiers");
+		CS_PROFILE_SCOPE("EntityManager::migrate");
+
+		// The clones would be generated from the free list the reservations rely on
+		if (destination.reserved) {
+			throw std::runtime_error("Spawns are pending");
+		}
+
+		auto ids = std::vector<EntityId>();
+
+		for (; first != last; ++first) {
+			const auto id = EntityId(*first);
+
+			validate(id);
+
+			const auto clone = destination.generate();
+
+			for (std::uint32_t uid = 0U; uid < sets.size(); ++uid) {
+				const auto cet = lookup(uid);
+
+				if (cet && (cet->contains(id) || cet->frozen(id))) {
+					own(uid)->transfer(id, destination.ensure(uid, *cet), clone);
+				}
+			}
+
+			release(id);
+			ids.push_back(clone);
+		}
+
+		CS_PROFILE_COUNT(ids.size());
+
+		return ids;
+	}
+
+	Prefab EntityManager::capture(EntityId id) const {
+		validate(id);
+
+		auto prefab = Prefab();
+		const auto ids = std::vector<EntityId>(1U, prefab.id);
+
+		for (std::uint32_t uid = 0U; uid < sets.size(); ++uid) {
+			const auto cet = lookup(uid);
+
+			if (cet && (cet->contains(id) || cet->frozen(id))) {
+				cet->replicate(id, prefab.storage.ensure(uid, *cet), ids);
+			}
+		}
+
+		return prefab;
+	}
+
+	std::vector<EntityId> EntityManager::instantiate(EntityId prototype, std::uint32_t count) {
+		validate(prototype);
+		return replicate(*this, prototype, count);
+	}
+
+	std::vector<EntityId> EntityManager::instantiate(const Prefab& prefab, std::uint32_t count) {
+		return replicate(prefab.storage, prefab.id, count);
+	}
+
+	void EntityManager::attach(EntityId child, EntityId parent) {
+		validate(child);
+
+		if (parent != Entity::INVALID) {
+			validate(parent);
+		}
+
+		tree.attach(child, parent);
+	}
+
+	void EntityManager::detach(EntityId child) {
+		validate(child);
+		tree.detach(child);
+	}
+
+	EntityId EntityManager::parent(EntityId id) const {
+		validate(id);
+		return tree.parent(id);
+	}
+
+	const Hierarchy& EntityManager::hierarchy() const {
+		return tree;
+	}
+
+	template <typename Component, typename... Components>
+	void EntityManager::arrange() {
+		tree.compact();
+		ensure<Component>().respect(tree);
+		arrange<Components...>();
+	}
+
+	template <typename Function>
+	void EntityManager::traverse(Function function) const {
+		tree.each(std::move(function));
+	}
+
+	template <typename Component>
+	void EntityManager::observe(ComponentListener<Component>& listener) {
+		auto& cet = ensure<Component>();
+
+		cet.listen(&listener);
+
+		// Bring the listener up to date with the components already assigned
+		cet.report(listener);
+	}
+
+	template <typename Component>
+	void EntityManager::unobserve(ComponentListener<Component>& listener) {
+		if (managed<Component>()) {
+			set<Component>().unlisten(&listener);
+		}
 	}
 
 	template <typename Component>
 	bool EntityManager::managed() const {
-		auto uid = ComponentFamily::uid<Component>();
-		return uid < sets.size() && sets[uid];
+		return lookup(ComponentFamily::uid<Component>()) != nullptr;
 	}
 
 	template <typename Component>
 	ComponentCollection<Component>& EntityManager::set() {
 		assert(managed<Component>());
-		return static_cast<ComponentCollection<Component>&>(*sets[ComponentFamily::uid<Component>()]);
+		return static_cast<ComponentCollection<Component>&>(*own(ComponentFamily::uid<Component>()));
 	}
 
 	template <typename Component>
@@ -284,13 +1033,84 @@ namespace cs
 			sets.resize(uid + 1);
 		}
 
-		if (!sets[uid]) {
+		if (!own(uid)) {
 			sets[uid] = std::make_unique<ComponentCollection<Component>>();
 		}
 
 		return set<Component>();
 	}
 
+	Collection& EntityManager::ensure(std::uint32_t uid, const Collection& prototype) {
+		if (uid >= sets.size()) {
+			sets.resize(uid + 1);
+		}
+
+		if (!own(uid)) {
+			sets[uid] = prototype.create();
+		}
+
+		return *sets[uid];
+	}
+
+	void EntityManager::clear(std::uint32_t uid) {
+		if (uid < sets.size()) {
+			if (sets[uid]) {
+				sets[uid]->clear();
+			}
+			else if (const auto source = lookup(uid)) { // Forks don't copy what they throw away
+				sets[uid] = source->create();
+			}
+		}
+	}
+
+	Collection* EntityManager::lookup(std::uint32_t uid) const {
+		return uid < sets.size() && sets[uid] ? sets[uid].get() : (base ? base->lookup(uid) : nullptr);
+	}
+
+	Collection* EntityManager::own(std::uint32_t uid) {
+		if (!sets[uid] && base) {
+			if (const auto source = base->lookup(uid)) {
+				sets[uid] = source->clone();
+			}
+		}
+
+		return sets[uid].get();
+	}
+
+	template <typename Component>
+	ComponentCollection<Component>& EntityManager::write() {
+		auto& cet = ensure<Component>();
+		cet.modify();
+		// Iterated components are in use, bring them back and keep them hot
+		cet.thaw();
+		cet.touch();
+		return cet;
+	}
+
+	std::vector<EntityId> EntityManager::replicate(const EntityManager& source, EntityId prototype, std::uint32_t count) {
+		CS_PROFILE_SCOPE("EntityManager::instantiate");
+		CS_PROFILE_COUNT(count);
+		auto ids = std::vector<EntityId>();
+
+		ids.reserve(count);
+		entities.reserve(entities.size() + count - std::min(count, available));
+
+		for (std::uint32_t i = 0U; i < count; ++i) {
+			ids.push_back(generate());
+		}
+
+		// One pass per set: each of them grows once and copies the prototype in a tight loop
+		for (std::uint32_t uid = 0U; uid < source.sets.size(); ++uid) {
+			const auto origin = source.lookup(uid);
+
+			if (origin && (origin->contains(prototype) || origin->frozen(prototype))) {
+				origin->replicate(prototype, ensure(uid, *origin), ids);
+			}
+		}
+
+		return ids;
+	}
+
 	template <typename... Components>
 	Collection& EntityManager::handler() {
 		//static_assert(sizeof...(Components) > 1, "!");
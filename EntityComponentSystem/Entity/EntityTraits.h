@@ -0,0 +1,52 @@
+#ifndef CORE_ENTITY_ENTITYTRAITS_H
+#define CORE_ENTITY_ENTITYTRAITS_H
+
+#include <cstdint>
+
+namespace cs
+{
+	/**
+	* @brief Layout of 32 bits identifiers.
+	*
+	* 24 bits of entity and 8 bits of version: up to 16M entities alive at once,
+	* versions wrap around after 256 reuses of a slot.
+	*/
+	struct EntityTraits32
+	{
+		using Type = std::uint32_t;
+
+		static const Type ID_MASK = 0xFFFFFF;
+		static const Type VERSION_MASK = 0xFF;
+		static const Type VERSION_SHIFT = 24;
+	};
+
+	/**
+	* @brief Layout of 64 bits identifiers.
+	*
+	* 32 bits of entity and 32 bits of version.
+	*/
+	struct EntityTraits64
+	{
+		using Type = std::uint64_t;
+
+		static const Type ID_MASK = 0xFFFFFFFF;
+		static const Type VERSION_MASK = 0xFFFFFFFF;
+		static const Type VERSION_SHIFT = 32;
+	};
+
+	/**
+	* @brief Layout of the identifiers used throughout the library.
+	*
+	* Identifiers are 32 bits wide by default. Define `CS_ENTITY_64` (the same
+	* way in every translation unit) to switch to 64 bits identifiers.
+	*/
+#ifdef CS_ENTITY_64
+	using EntityTraits = EntityTraits64;
+#else
+	using EntityTraits = EntityTraits32;
+#endif
+
+	using EntityId = EntityTraits::Type;
+}
+
+#endif
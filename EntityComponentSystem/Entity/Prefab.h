@@ -0,0 +1,56 @@
+#ifndef CORE_ENTITY_PREFAB_H
+#define CORE_ENTITY_PREFAB_H
+
+#include <cstdint>
+#include <type_traits>
+#include "EntityManager.h"
+
+namespace cs
+{
+	/**
+	* @brief Template of entities.
+	*
+	* A prefab is a bundle of components kept apart from any manager, thus it's
+	* never returned by views nor iterated by systems. It's either declared
+	* component by component or captured from a living entity through
+	* `EntityManager::capture`.<br/>
+	* `EntityManager::instantiate` copies the whole bundle into as many new
+	* entities as required, one set at a time.
+	*
+	* @note
+	* Components must be copy constructible to be instantiated.
+	*/
+	class Prefab final
+	{
+	public:
+		Prefab();
+		Prefab(const Prefab&) = delete;
+		Prefab(Prefab&&) = default;
+
+		Prefab& operator=(const Prefab&) = delete;
+		Prefab& operator=(Prefab&&) = default;
+
+		template <typename Component, typename... Args>
+		Component& assign(Args&&... args);
+
+		template <typename Component>
+		std::decay_t<Component>& assign(Component&& component);
+
+		template <typename Component, typename... Components>
+		void remove();
+
+		template <typename Component, typename... Components>
+		bool has();
+
+		template <typename Component>
+		Component& component();
+
+	private:
+		friend class EntityManager;
+
+		EntityManager storage;
+		EntityId id;
+	};
+}
+
+#endif
@@ -0,0 +1,41 @@
+#ifndef CORE_ENTITY_PREFAB_IMPL_H
+#define CORE_ENTITY_PREFAB_IMPL_H
+
+#include <utility>
+#include "Prefab.h"
+#include "EntityManager.hpp"
+
+namespace cs
+{
+	Prefab::Prefab()
+		: storage()
+		, id(storage.create().id())
+	{}
+
+	template <typename Component, typename... Args>
+	Component& Prefab::assign(Args&&... args) {
+		return storage.assign<Component>(id, std::forward<Args>(args)...);
+	}
+
+	template <typename Component>
+	std::decay_t<Component>& Prefab::assign(Component&& component) {
+		return storage.assign(id, std::forward<Component>(component));
+	}
+
+	template <typename Component, typename... Components>
+	void Prefab::remove() {
+		storage.remove<Component, Components...>(id);
+	}
+
+	template <typename Component, typename... Components>
+	bool Prefab::has() {
+		return storage.has<Component, Components...>(id);
+	}
+
+	template <typename Component>
+	Component& Prefab::component() {
+		return storage.component<Component>(id);
+	}
+}
+
+#endif
@@ -0,0 +1,88 @@
+#ifndef CORE_ENTITY_SHARDEDMANAGER_H
+#define CORE_ENTITY_SHARDEDMANAGER_H
+
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <condition_variable>
+#include "EntityManager.h"
+
+namespace cs
+{
+	/**
+	* @brief World split into several entity managers, each one driven by a
+	* thread of its own.
+	*
+	* Every shard is a whole EntityManager with its own entities and sets and
+	* it's only ever touched by its worker: work submitted through `run`,
+	* `broadcast`, `each` and `reduce` is executed by the workers of the shards
+	* involved, in parallel, and the caller waits for it to complete. Since the
+	* memory of a shard is first touched by its worker, pinning the workers
+	* (see the constructor) keeps each shard on the memory node of its cores.<br/>
+	* Identifiers are local to their shard, a pair of shard and identifier
+	* identifies an entity within the world. `migrate` moves entities along
+	* with their components from a shard to another.
+	*
+	* @note
+	* Member functions must be invoked from a single thread. Functions given
+	* to `broadcast`, `each` and `reduce` are invoked concurrently by the
+	* workers, one shard each, and must be safe to run that way.
+	*/
+	class ShardedManager final
+	{
+	public:
+		using Pin = std::function<void(std::uint32_t)>;
+
+		explicit ShardedManager(std::uint32_t count, Pin pin = nullptr);
+		ShardedManager(const ShardedManager&) = delete;
+		~ShardedManager();
+
+		ShardedManager& operator=(const ShardedManager&) = delete;
+
+		std::uint32_t shards() const;
+		std::uint32_t size() const;
+		EntityManager& shard(std::uint32_t index);
+
+		template <typename Function>
+		void run(std::uint32_t index, Function function);
+
+		template <typename Function>
+		void broadcast(Function function);
+
+		template <typename Component, typename... Components, typename Function>
+		void each(Function function);
+
+		template <typename Component, typename... Components, typename Type, typename Map, typename Combine>
+		Type reduce(Type init, Map map, Combine combine);
+
+		template <typename Iterator>
+		std::vector<EntityId> migrate(std::uint32_t from, Iterator first, Iterator last, std::uint32_t to);
+
+	private:
+		struct Shard
+		{
+			EntityManager manager;
+			std::thread thread;
+			std::function<void()> task;
+			std::exception_ptr error;
+			bool stop = false;
+		};
+
+		void dispatch(std::uint32_t first, std::uint32_t last, const std::function<void(std::uint32_t)>& task);
+		void shutdown();
+		void work(std::uint32_t index, Pin pin);
+
+	private:
+		std::mutex mutex;
+		std::condition_variable wake; // Workers wait here for their tasks
+		std::condition_variable done; // The caller waits here for the workers
+		std::uint32_t pending = 0U;
+		std::vector<std::unique_ptr<Shard>> workers;
+	};
+}
+
+#endif
@@ -0,0 +1,270 @@
+#ifndef CORE_ENTITY_SHARDEDMANAGER_IMPL_H
+#define CORE_ENTITY_SHARDEDMANAGER_IMPL_H
+
+#include <stdexcept>
+#include "ShardedManager.h"
+#include "EntityManager.hpp"
+
+namespace cs
+{
+	/**
+	* @brief Creates the shards and starts their workers.
+	*
+	* @param count Number of shards, one worker thread each.
+	* @param pin Invoked by each worker with the index of its shard before
+	* anything else, the place to set the affinity of the thread.
+	*/
+	ShardedManager::ShardedManager(std::uint32_t count, Pin pin) {
+		if (!count) {
+			throw std::runtime_error("At least a shard is required");
+		}
+
+		workers.reserve(count);
+
+		for (std::uint32_t index = 0U; index < count; ++index) {
+			workers.push_back(std::make_unique<Shard>());
+		}
+
+		try {
+			for (std::uint32_t index = 0U; index < count; ++index) {
+				workers[index]->thread = std::thread(&ShardedManager::work, this, index, pin);
+			}
+		}
+		catch (...) {
+			shutdown();
+			throw;
+		}
+	}
+
+	ShardedManager::~ShardedManager() {
+		shutdown();
+	}
+
+	std::uint32_t ShardedManager::shards() const {
+		return std::uint32_t(workers.size());
+	}
+
+	/**
+	* @brief Returns the number of entities alive among all the shards.
+	*/
+	std::uint32_t ShardedManager::size() const {
+		auto size = std::uint32_t(0);
+
+		for (auto&& worker : workers) {
+			size += worker->manager.size();
+		}
+
+		return size;
+	}
+
+	/**
+	* @brief Direct access to a shard.
+	*
+	* @warning
+	* Memory allocated this way belongs to the memory node of the caller, use
+	* `run` to populate the shard from its worker instead.
+	*/
+	EntityManager& ShardedManager::shard(std::uint32_t index) {
+		return workers[index]->manager;
+	}
+
+	/**
+	* @brief Runs a function on the worker of a shard and waits for it.
+	*
+	* The signature of the function should be equivalent to the following:
+	*
+	* @code{.cpp}
+	* void(EntityManager&);
+	* @endcode
+	*/
+	template <typename Function>
+	void ShardedManager::run(std::uint32_t index, Function function) {
+		dispatch(index, index + 1U, [this, &function](std::uint32_t index) {
+			function(workers[index]->manager);
+		});
+	}
+
+	/**
+	* @brief Runs a function on the workers of all the shards at once and waits
+	* for them.
+	*
+	* The signature of the function should be equivalent to the following:
+	*
+	* @code{.cpp}
+	* void(EntityManager&, std::uint32_t);
+	* @endcode
+	*/
+	template <typename Function>
+	void ShardedManager::broadcast(Function function) {
+		dispatch(0U, shards(), [this, &function](std::uint32_t index) {
+			function(workers[index]->manager, index);
+		});
+	}
+
+	/**
+	* @brief Iterates the entities that have the given components, each shard
+	* on its own worker.
+	*
+	* Identifiers received by the function are local to their shard.
+	*/
+	template <typename Component, typename... Components, typename Function>
+	void ShardedManager::each(Function function) {
+		CS_PROFILE_SCOPE("ShardedManager::each");
+		broadcast([&function](EntityManager& manager, std::uint32_t) {
+			manager.each<Component, Components...>(function);
+		});
+	}
+
+	/**
+	* @brief Maps the entities that have the given components and combines the
+	* results, each shard on its own worker.
+	*
+	* Shards are reduced sequentially by their workers, then the partial
+	* results are combined by the caller. As for `EntityManager::reduce`, the
+	* initial value must be the identity of the combine function.
+	*/
+	template <typename Component, typename... Components, typename Type, typename Map, typename Combine>
+	Type ShardedManager::reduce(Type init, Map map, Combine combine) {
+		CS_PROFILE_SCOPE("ShardedManager::reduce");
+		// Each worker writes its own slot, padded so that no two of them share a cache line
+		struct Partial
+		{
+			Type value;
+			char padding[64];
+		};
+
+		auto partials = std::vector<Partial>(shards(), Partial{ init, {} });
+
+		broadcast([&partials, &map, &combine](EntityManager& manager, std::uint32_t index) {
+			auto partial = partials[index].value; // Accumulated locally, written back once
+
+			manager.view<Component, Components...>().each([&partial, &map, &combine](EntityId id, auto&... components) {
+				partial = combine(std::move(partial), map(id, components...));
+			});
+
+			partials[index].value = std::move(partial);
+		});
+
+		auto result = std::move(partials.front().value);
+
+		for (std::uint32_t index = 1U; index < partials.size(); ++index) {
+			result = combine(std::move(result), std::move(partials[index].value));
+		}
+
+		return result;
+	}
+
+	/**
+	* @brief Moves entities and their components from a shard to another.
+	*
+	* The move runs on the worker of the destination, so that the memory of
+	* the new components belongs to its node. Both shards are idle meanwhile.
+	*
+	* @return The identifiers of the entities within the destination, in the
+	* same order.
+	*/
+	template <typename Iterator>
+	std::vector<EntityId> ShardedManager::migrate(std::uint32_t from, Iterator first, Iterator last, std::uint32_t to) {
+		CS_PROFILE_SCOPE("ShardedManager::migrate");
+		auto ids = std::vector<EntityId>();
+
+		if (from == to) {
+			throw std::runtime_error("Entities can't migrate to their own shard");
+		}
+
+		run(to, [this, from, &first, &last, &ids](EntityManager& destination) {
+			ids = workers[from]->manager.migrate(first, last, destination);
+		});
+
+		return ids;
+	}
+
+	void ShardedManager::dispatch(std::uint32_t first, std::uint32_t last, const std::function<void(std::uint32_t)>& task) {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+
+			for (auto index = first; index < last; ++index) {
+				workers[index]->task = [&task, index]() { task(index); };
+			}
+
+			pending = last - first;
+		}
+
+		wake.notify_all();
+
+		std::unique_lock<std::mutex> lock(mutex);
+		done.wait(lock, [this]() { return pending == 0U; });
+
+		auto error = std::exception_ptr();
+
+		for (auto index = first; index < last; ++index) {
+			if (!error) {
+				error = workers[index]->error;
+			}
+
+			workers[index]->error = nullptr;
+		}
+
+		if (error) {
+			std::rethrow_exception(error);
+		}
+	}
+
+	/**
+	* @brief Stops the workers and waits for them, those not started are skipped.
+	*/
+	void ShardedManager::shutdown() {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+
+			for (auto&& worker : workers) {
+				worker->stop = true;
+			}
+		}
+
+		wake.notify_all();
+
+		for (auto&& worker : workers) {
+			if (worker->thread.joinable()) {
+				worker->thread.join();
+			}
+		}
+	}
+
+	void ShardedManager::work(std::uint32_t index, Pin pin) {
+		auto& shard = *workers[index];
+
+		if (pin) {
+			pin(index);
+		}
+
+		std::unique_lock<std::mutex> lock(mutex);
+
+		for (;;) {
+			wake.wait(lock, [&shard]() { return shard.stop || shard.task; });
+
+			if (shard.stop) {
+				return;
+			}
+
+			auto task = std::move(shard.task);
+			shard.task = nullptr;
+			lock.unlock();
+
+			try {
+				task();
+			}
+			catch (...) {
+				shard.error = std::current_exception();
+			}
+
+			lock.lock();
+
+			if (--pending == 0U) {
+				done.notify_all();
+			}
+		}
+	}
+}
+
+#endif
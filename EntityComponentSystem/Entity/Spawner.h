@@ -0,0 +1,80 @@
+#ifndef CORE_ENTITY_SPAWNER_H
+#define CORE_ENTITY_SPAWNER_H
+
+#include <atomic>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <type_traits>
+#include "EntityManager.h"
+
+namespace cs
+{
+	/**
+	* @brief Creates entities from several threads at once.
+	*
+	* Identifiers are claimed up front by `reserve`, recycled ones first, then
+	* handed out by `spawn` with a single atomic increment. Components assigned
+	* by means of `assign` are buffered in a lock-free stack and reach the
+	* manager on `commit`, along with the entities themselves: until then the
+	* spawned identifiers aren't valid for the manager.<br/>
+	* `spawn` and `assign` can be invoked concurrently from any thread, all the
+	* other member functions belong to the thread that owns the manager.
+	* Components assigned by the same thread are committed in order.
+	*
+	* @note
+	* Identifiers reserved but not spawned go back to the manager on commit.
+	* Destroying the spawner commits whatever is pending.
+	*/
+	class Spawner final
+	{
+	public:
+		explicit Spawner(EntityManager& manager);
+		Spawner(const Spawner&) = delete;
+		~Spawner();
+
+		Spawner& operator=(const Spawner&) = delete;
+
+		void reserve(std::uint32_t count);
+		EntityId spawn();
+
+		template <typename Component, typename... Args>
+		void assign(EntityId id, Args&&... args);
+
+		template <typename Component>
+		void assign(EntityId id, Component&& component);
+
+		void commit();
+
+	private:
+		struct Command
+		{
+			virtual ~Command() = default;
+			virtual void apply(EntityManager& manager) = 0;
+
+			Command* next = nullptr;
+			EntityId id = Entity::INVALID;
+		};
+
+		template <typename Component>
+		struct Assignment final : Command
+		{
+			template <typename... Args>
+			Assignment(Args&&... args);
+
+			void apply(EntityManager& manager) override;
+
+			Component component;
+		};
+
+		void push(Command* command);
+
+	private:
+		EntityManager& manager;
+		std::vector<EntityId> claimed; // Reserved identifiers, spawned ones come first
+		std::atomic<std::uint32_t> cursor;
+		std::atomic<Command*> head;
+	};
+}
+
+#endif
@@ -0,0 +1,159 @@
+#ifndef CORE_ENTITY_SPAWNER_IMPL_H
+#define CORE_ENTITY_SPAWNER_IMPL_H
+
+#include <algorithm>
+#include <stdexcept>
+#include "Spawner.h"
+#include "EntityManager.hpp"
+
+namespace cs
+{
+	Spawner::Spawner(EntityManager& manager)
+		: manager(manager)
+		, cursor(0U)
+		, head(nullptr)
+	{}
+
+	Spawner::~Spawner() {
+		commit();
+	}
+
+	/**
+	* @brief Claims identifiers for the threads to spawn, pending ones are
+	* committed first.
+	*
+	* Recycled identifiers are taken from the manager first, then new slots
+	* are appended to it all at once.
+	*/
+	void Spawner::reserve(std::uint32_t count) {
+		CS_PROFILE_SCOPE("Spawner::reserve");
+		CS_PROFILE_COUNT(count);
+
+		if (!claimed.empty()) {
+			commit();
+		}
+
+		claimed.reserve(count);
+
+		// Counted as reserved right away, so that a throw below leaves them to commit
+		for (; claimed.size() < count && manager.available; --manager.available, ++manager.reserved) {
+			const auto entity = manager.next;
+
+			// The slot keeps linking elsewhere, so the identifier isn't valid until committed
+			claimed.push_back(entity | (manager.entities[entity] & (~Entity::ID_MASK)));
+			manager.next = manager.entities[entity] & Entity::ID_MASK;
+		}
+
+		const auto first = EntityId(manager.entities.size());
+		const auto rest = count - std::uint32_t(claimed.size());
+
+		if (std::uint64_t(first) + rest > Entity::ID_MASK) {
+			throw std::runtime_error("Out of entities");
+		}
+
+		manager.entities.resize(first + rest, Entity::INVALID);
+
+		for (auto entity = first; entity < first + rest; ++entity) {
+			claimed.push_back(entity);
+		}
+
+		manager.reserved += rest;
+	}
+
+	/**
+	* @brief Hands out one of the reserved identifiers, it's safe to invoke
+	* from any thread.
+	*/
+	EntityId Spawner::spawn() {
+		const auto index = cursor.fetch_add(1U, std::memory_order_relaxed);
+
+		if (index >= claimed.size()) {
+			throw std::runtime_error("No identifiers left to spawn");
+		}
+
+		return claimed[index];
+	}
+
+	/**
+	* @brief Buffers a component constructed from the given arguments, it's
+	* safe to invoke from any thread.
+	*/
+	template <typename Component, typename... Args>
+	void Spawner::assign(EntityId id, Args&&... args) {
+		auto command = std::make_unique<Assignment<Component>>(std::forward<Args>(args)...);
+		command->id = id;
+		push(command.release());
+	}
+
+	template <typename Component>
+	void Spawner::assign(EntityId id, Component&& component) {
+		auto command = std::make_unique<Assignment<std::decay_t<Component>>>(std::forward<Component>(component));
+		command->id = id;
+		push(command.release());
+	}
+
+	/**
+	* @brief Makes the spawned entities valid and assigns the buffered
+	* components.
+	*
+	* @warning
+	* No thread must spawn or assign meanwhile.
+	*/
+	void Spawner::commit() {
+		CS_PROFILE_SCOPE("Spawner::commit");
+		const auto spawned = std::min(cursor.load(std::memory_order_acquire), std::uint32_t(claimed.size()));
+		auto commands = std::vector<std::unique_ptr<Command>>();
+
+		for (std::uint32_t i = 0U; i < spawned; ++i) {
+			const auto id = claimed[i];
+			manager.entities[id & Entity::ID_MASK] = id;
+
+			if (manager.log) {
+				manager.log->created(id);
+			}
+		}
+
+		// Leftovers go back to the free list with their versions untouched
+		for (auto i = spawned; i < claimed.size(); ++i) {
+			const auto entity = claimed[i] & Entity::ID_MASK;
+			const auto link = manager.available ? manager.next : ((entity + 1U) & Entity::ID_MASK);
+
+			manager.entities[entity] = link | (claimed[i] & (~Entity::ID_MASK));
+			manager.next = entity;
+			++manager.available;
+		}
+
+		manager.reserved -= std::uint32_t(claimed.size());
+		claimed.clear();
+		cursor.store(0U, std::memory_order_relaxed);
+
+		// The stack is in reverse order of submission
+		for (auto command = head.exchange(nullptr, std::memory_order_acquire); command; command = command->next) {
+			commands.emplace_back(command);
+		}
+
+		CS_PROFILE_COUNT(commands.size());
+
+		for (auto it = commands.rbegin(); it != commands.rend(); ++it) {
+			(*it)->apply(manager);
+		}
+	}
+
+	void Spawner::push(Command* command) {
+		command->next = head.load(std::memory_order_relaxed);
+		while (!head.compare_exchange_weak(command->next, command, std::memory_order_release, std::memory_order_relaxed));
+	}
+
+	template <typename Component>
+	template <typename... Args>
+	Spawner::Assignment<Component>::Assignment(Args&&... args)
+		: component(std::forward<Args>(args)...)
+	{}
+
+	template <typename Component>
+	void Spawner::Assignment<Component>::apply(EntityManager& manager) {
+		manager.assign<Component>(id, std::move(component));
+	}
+}
+
+#endif
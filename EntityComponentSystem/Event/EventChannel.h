@@ -0,0 +1,88 @@
+#ifndef EVENT_EVENT_CHANNEL_H
+#define EVENT_EVENT_CHANNEL_H
+
+#include <array>
+#include <mutex>
+#include <vector>
+#include <cstdint>
+
+namespace cs
+{
+	/**
+	* @brief Position of a reader within a channel, see EventChannel::read.
+	*/
+	struct EventReader
+	{
+		std::uint64_t next = 0U; // Sequence number of the first event not read yet
+	};
+
+	/**
+	* @brief Type-erased channel, so that a manager can flush them all.
+	*/
+	class Channel
+	{
+	public:
+		virtual ~Channel() = default;
+
+		virtual void flush() = 0;
+		virtual void clear() = 0;
+
+	protected:
+		static std::uint32_t thread();
+	};
+
+	/**
+	* @brief Queue of events of a given type.
+	*
+	* Events published during a frame are buffered per thread and become
+	* readable on `flush`, all at once in a contiguous array, replacing the
+	* ones of the previous frame. Each reader keeps its own cursor, thus any
+	* number of systems can read the same events, each one only once.
+	*
+	* @note
+	* `publish` can be invoked concurrently from any thread, events published
+	* by the same thread keep their order. Everything else belongs to the
+	* thread that flushes the channel and must not overlap with `flush`.<br/>
+	* Readers must read every frame, events are dropped by the second `flush`
+	* after they have been published.
+	*
+	* @tparam Event Type of events carried by the channel.
+	*/
+	template <typename Event>
+	class EventChannel final : public Channel
+	{
+	public:
+		static const std::uint32_t STRIPES = 16U; // Buffers shared among the threads that publish
+
+		EventChannel() = default;
+		EventChannel(const EventChannel&) = delete;
+
+		EventChannel& operator=(const EventChannel&) = delete;
+
+		template <typename... Args>
+		void publish(Args&&... args);
+
+		void flush() override;
+		void clear() override;
+
+		template <typename Function>
+		std::uint32_t read(EventReader& reader, Function function) const;
+
+		std::uint32_t size() const;
+		const Event* data() const;
+
+	private:
+		struct Stripe
+		{
+			std::mutex mutex; // Uncontended unless more threads than stripes publish at once
+			std::vector<Event> events;
+		};
+
+	private:
+		std::array<Stripe, STRIPES> stripes;
+		std::vector<Event> events; // Readable events, published before the last flush
+		std::uint64_t base = 0U; // Sequence number of the first readable event
+	};
+}
+
+#endif
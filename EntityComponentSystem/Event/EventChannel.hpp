@@ -0,0 +1,113 @@
+#ifndef EVENT_EVENT_CHANNEL_IMPL
+#define EVENT_EVENT_CHANNEL_IMPL
+
+#include <atomic>
+#include <iterator>
+#include <algorithm>
+#include "EventChannel.h"
+
+namespace cs
+{
+	/**
+	* @brief Returns a small number that identifies the calling thread.
+	*/
+	std::uint32_t Channel::thread() {
+		static std::atomic<std::uint32_t> threads(0U);
+		thread_local const auto index = threads++;
+		return index;
+	}
+
+	template <typename Event>
+	const std::uint32_t EventChannel<Event>::STRIPES;
+
+	/**
+	* @brief Publishes an event constructed from the given arguments, it's safe
+	* to invoke from any thread.
+	*
+	* The event is readable after the next `flush`.
+	*/
+	template <typename Event>
+	template <typename... Args>
+	void EventChannel<Event>::publish(Args&&... args) {
+		auto& stripe = stripes[thread() % STRIPES];
+		std::lock_guard<std::mutex> lock(stripe.mutex);
+		stripe.events.emplace_back(std::forward<Args>(args)...);
+	}
+
+	/**
+	* @brief Drops the readable events and makes the ones published since the
+	* last flush readable in their place.
+	*
+	* Buffers keep their capacity, a steady flow of events doesn't allocate.
+	*/
+	template <typename Event>
+	void EventChannel<Event>::flush() {
+		base += events.size();
+		events.clear();
+
+		for (auto& stripe : stripes) {
+			std::lock_guard<std::mutex> lock(stripe.mutex);
+			events.insert(events.end(), std::make_move_iterator(stripe.events.begin()), std::make_move_iterator(stripe.events.end()));
+			stripe.events.clear();
+		}
+	}
+
+	/**
+	* @brief Drops all the events, both readable and published.
+	*/
+	template <typename Event>
+	void EventChannel<Event>::clear() {
+		base += events.size();
+		events.clear();
+
+		for (auto& stripe : stripes) {
+			std::lock_guard<std::mutex> lock(stripe.mutex);
+			stripe.events.clear();
+		}
+	}
+
+	/**
+	* @brief Invokes a function for each readable event the reader hasn't read
+	* yet, in order, and moves the reader past them.
+	*
+	* The signature of the function should be equivalent to the following:
+	*
+	* @code{.cpp}
+	* void(const Event&);
+	* @endcode
+	*
+	* @return The number of events read.
+	*/
+	template <typename Event>
+	template <typename Function>
+	std::uint32_t EventChannel<Event>::read(EventReader& reader, Function function) const {
+		const auto first = std::max(reader.next, base);
+		const auto last = base + events.size();
+
+		for (auto i = first; i < last; ++i) {
+			function(static_cast<const Event&>(events[std::size_t(i - base)]));
+		}
+
+		reader.next = last;
+
+		return std::uint32_t(last - first);
+	}
+
+	/**
+	* @brief Returns the number of readable events.
+	*/
+	template <typename Event>
+	std::uint32_t EventChannel<Event>::size() const {
+		return std::uint32_t(events.size());
+	}
+
+	/**
+	* @brief Direct access to the readable events, `size` of them.
+	*/
+	template <typename Event>
+	const Event* EventChannel<Event>::data() const {
+		return events.data();
+	}
+}
+
+#endif
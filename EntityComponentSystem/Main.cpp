@@ -1,7 +1,24 @@
 #include <stdio.h>
+#include <memory>
+#include <algorithm>
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <iterator>
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+#include <execution>
+#endif
 
 #include "Entity\EntityManager.hpp"
 #include "Entity\Entity.hpp"
+#include "Entity\Prefab.hpp"
+#include "Component\Index\SpatialIndex.hpp"
+#include "Replication\ChangeReplay.hpp"
+#include "Replication\Rollback.hpp"
+#include "Entity\ShardedManager.hpp"
+#include "Entity\Spawner.hpp"
+#include "Component\Index\HashIndex.hpp"
+#include "Component\Index\OrderedIndex.hpp"
 
 struct Position
 {
@@ -84,6 +101,34 @@ void accomodation(cs::EntityManager& m)
 	assert(e2.has<double>() && e2.component<double>() == 68.0);
 }
 
+void emplacement(cs::EntityManager& m)
+{
+	auto c1 = std::make_unique<int>(5);
+
+	auto e1 = m.create();
+	auto e2 = m.create(std::move(c1), 12.f); // Move component
+
+	auto& p = e1.assign<Position>(3, 4); // Construct in place
+	auto& u = e1.assign(std::make_unique<int>(7)); // Move-only component
+
+	p.x = 9;
+	e2.replace(std::make_unique<int>(8)); // Move and replace
+
+	auto thrown = false;
+
+	try {
+		e2.replace<Position>(1, 1); // Not owned
+	}
+	catch (const std::runtime_error&) {
+		thrown = true;
+	}
+
+	assert(thrown && !e2.has<Position>());
+	assert(e1.component<Position>().x == 9);
+	assert(*u == 7 && *e1.component<std::unique_ptr<int>>() == 7);
+	assert(*e2.component<std::unique_ptr<int>>() == 8);
+}
+
 void resetion(cs::EntityManager& m)
 {
 	auto c1 = 89;
@@ -201,6 +246,792 @@ void components(cs::EntityManager& m) {
 	auto c2 = e2.components<float, double>();
 }
 
+void hierarchy() {
+	cs::EntityManager m;
+
+	auto root = m.create<int>(1);
+	auto e1 = m.create<int>(2);
+	auto e2 = m.create<int>(3);
+	auto e3 = m.create<int>(4);
+
+	e3.attach(e1);
+	e1.attach(root);
+	e2.attach(root);
+	m.arrange<int>();
+
+	auto order = std::vector<std::uint32_t>();
+
+	m.each<int>([&order](auto e, int& i) {
+		order.push_back(e);
+	});
+
+	assert(e3.parent() == e1 && e1.parent() == root);
+	assert(m.hierarchy().extent(root.id()) == 4U);
+	assert(order[0] == root.id() && order[1] == e1.id() && order[2] == e3.id() && order[3] == e2.id());
+
+	e1.destroy();
+
+	assert(e3.parent() == root && m.hierarchy().tombstones() == 1U);
+
+	m.compact();
+
+	assert(m.hierarchy().extent(root.id()) == 3U && m.hierarchy().tombstones() == 0U);
+}
+
+void merging() {
+	cs::EntityManager m;
+	cs::EntityManager staging;
+
+	auto e1 = m.create<int>(1);
+	auto e2 = staging.create<int>(2);
+	auto e3 = staging.create(3, 4.f);
+
+	auto table = m.merge(std::move(staging));
+	auto id = table[e3.id() & cs::Entity::ID_MASK];
+
+	assert(staging.empty() && m.size() == 3U);
+	assert(m.count<int>() == 3U && m.count<float>() == 1U);
+	assert(m.component<int>(id) == 3 && m.component<float>(id) == 4.f);
+}
+
+void instancing() {
+	cs::EntityManager m;
+	cs::Prefab prefab;
+
+	prefab.assign<Position>(4, 2);
+	prefab.assign(1.5f);
+
+	auto ids = m.instantiate(prefab, 50U);
+	auto copies = m.instantiate(ids.front(), 50U);
+
+	assert(m.size() == 100U && m.count<Position>() == 100U);
+	assert(m.component<Position>(copies.back()).x == 4 && m.component<float>(copies.back()) == 1.5f);
+}
+
+void stability() {
+	cs::EntityManager m;
+
+	auto e1 = m.create<int>(3);
+	auto e2 = m.create<int>(1);
+	auto e3 = m.create<int>(2);
+
+	m.sort<int>([](int lhs, int rhs) { return lhs < rhs; });
+	m.stabilize<int>();
+	e2.remove<int>(); // Leaves a tombstone, order is preserved
+
+	auto order = std::vector<int>();
+
+	m.each<int>([&order](auto e, int& i) {
+		order.push_back(i);
+	});
+
+	assert(m.count<int>() == 2U && order[0] == 2 && order[1] == 3);
+
+	m.compact<int>();
+
+	assert(m.count<int>() == 2U);
+}
+
+void locality() {
+	cs::EntityManager m;
+	cs::SpatialIndex<Position> index(4.f);
+
+	auto e1 = m.create<Position>(0, 0);
+	auto e2 = m.create<Position>(3, 4);
+	auto e3 = m.create<Position>(20, 20);
+
+	m.observe(index);
+	e2.replace<Position>(1, 1); // Moved close to the first one
+
+	auto near = index.range(0.f, 0.f, 2.f);
+	auto nearest = index.nearest(19.f, 19.f, 2U);
+
+	assert(index.size() == 3U && near.size() == 2U);
+	assert(nearest[0] == e3.id() && nearest[1] == e2.id());
+
+	e3.destroy();
+
+	assert(index.size() == 2U && index.range(20.f, 20.f, 5.f).empty());
+
+	m.unobserve(index);
+}
+
+void validation() {
+	cs::EntityManager m;
+
+	auto e1 = m.create<int>(3);
+	auto id = e1.id();
+
+	e1.destroy();
+
+#ifndef CS_UNCHECKED
+	auto thrown = false;
+
+	try {
+		m.component<int>(id); // Stale identifier
+	}
+	catch (const std::runtime_error&) {
+		thrown = true;
+	}
+
+	assert(thrown);
+#endif
+
+	auto sum = 0;
+	auto e2 = m.create<int>(4); // Recycles the slot with a new version
+
+	m.each<int>([&m, &sum](auto e, int& i) {
+		sum += m.get<int>(e); // Unchecked
+	});
+
+	assert(!m.valid(id) && m.valid(e2.id()));
+	assert(sum == 4);
+}
+
+void accounting() {
+	cs::EntityManager m;
+
+	auto ids = std::vector<cs::EntityId>();
+
+	for (auto i = 0; i < 100; ++i) {
+		ids.push_back(m.create<Position>(i, i).id());
+	}
+
+	for (auto id : ids) {
+		m.destroy(id);
+	}
+
+	auto e1 = m.create<Position>(1, 1);
+	auto before = m.footprint();
+
+	m.shrink_to_fit();
+
+	assert(before.available == 99U && m.footprint().total() < before.total());
+	assert(m.footprint<Position>().dense == sizeof(cs::EntityId) + sizeof(Position));
+	assert(m.footprint<Position>().slack == 0U);
+
+	m.reserve<Position>(10U);
+
+	assert(m.footprint<Position>().slack == 9U * (sizeof(cs::EntityId) + sizeof(Position)));
+}
+
+void profiling() {
+	cs::Profiler::clear();
+
+	{
+		cs::ProfileScope scope("profiling");
+		scope.add(5U);
+	}
+
+	assert(cs::Profiler::dump("trace.json"));
+
+	auto file = std::ifstream("trace.json");
+	auto trace = std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+	assert(trace.find("\"name\":\"profiling\"") != std::string::npos);
+	assert(trace.find("\"entities\":5") != std::string::npos);
+
+	cs::Profiler::clear();
+}
+
+void versioning() {
+	cs::EntityManager m;
+
+	auto e1 = m.create<int>(0);
+	auto id = e1.id();
+
+	for (auto i = 1; i <= 300; ++i) {
+		m.destroy(id);
+		id = m.create<int>(i).id(); // Always recycles the same slot
+	}
+
+	assert((id & cs::Entity::ID_MASK) == (e1.id() & cs::Entity::ID_MASK));
+	assert(m.current(id) == 300U % (cs::Entity::VERSION_MASK + 1U));
+	assert(!m.valid(e1.id()) && m.component<int>(id) == 300);
+}
+
+void ranges() {
+	cs::EntityManager m;
+
+	for (auto i = 0; i < 10; ++i) {
+		auto e = m.create<int>(i);
+
+		if (i % 2 == 0) {
+			e.assign<float>(float(i));
+		}
+	}
+
+	auto v1 = m.view<int>();
+	auto v2 = m.view<int, float>();
+
+	auto odd = std::count_if(v1.begin(), v1.end(), [](std::tuple<cs::EntityId, int&> t) {
+		return std::get<1>(t) % 2 != 0;
+	});
+
+	auto it = std::find_if(v2.begin(), v2.end(), [](std::tuple<cs::EntityId, int&, float&> t) {
+		return std::get<2>(t) == 4.f;
+	});
+
+	assert(std::distance(v1.begin(), v1.end()) == 10 && odd == 5);
+	assert(std::distance(v2.begin(), v2.end()) == 5);
+	assert(it != v2.end() && std::get<1>(*it) == 4);
+	assert(v1.end() - v1.begin() == 10 && std::get<1>(v1.begin()[3]) == 3); // Random access
+
+#ifdef __cpp_lib_execution
+	std::for_each(std::execution::par_unseq, v1.begin(), v1.end(), [](std::tuple<cs::EntityId, int&> t) {
+		std::get<1>(t) *= 2;
+	});
+
+	assert(std::get<1>(v1.begin()[3]) == 6 && std::get<1>(*(v1.end() - 1)) == 18);
+#endif
+}
+
+void reduction() {
+	cs::EntityManager m;
+
+	for (auto i = 0; i < 20000; ++i) {
+		auto e = m.create<int>(i);
+
+		if (i % 2 == 0) {
+			e.assign<float>(1.f);
+		}
+	}
+
+	auto sum = [](long long lhs, long long rhs) { return lhs + rhs; };
+	auto total = m.reduce<int>(0LL, [](cs::EntityId, int i) { return (long long)i; }, sum);
+	auto count = m.reduce<int, float>(0LL, [](cs::EntityId, int&, float&) { return 1LL; }, sum);
+	auto thrown = false;
+
+	try {
+		m.reduce<int>(0LL, [](cs::EntityId, int i) -> long long {
+			if (i == 15000) {
+				throw std::runtime_error("Failed");
+			}
+
+			return i;
+		}, sum);
+	}
+	catch (const std::runtime_error&) {
+		thrown = true; // Propagated once the workers are joined
+	}
+
+	assert(total == 19999LL * 20000LL / 2LL && count == 10000LL);
+	assert(thrown);
+}
+
+void sharing() {
+	using Material = cs::Shared<std::string>;
+
+	cs::EntityManager m;
+
+	auto e1 = m.create();
+	auto e2 = m.create();
+	auto e3 = m.create();
+
+	e1.assign<Material>("stone");
+	e2.assign<Material>("stone");
+	e3.assign<Material>("wood");
+
+	assert(e1.component<Material>() == e2.component<Material>());
+	assert(e1.component<Material>().references() == 2U);
+
+	e2.replace<Material>(std::string("wood")); // Shares the value of the third one
+
+	auto groups = 0;
+	auto wood = 0;
+
+	m.group<Material>([&groups, &wood](const std::string& value, const cs::EntityId* first, const cs::EntityId* last) {
+		wood += value == "wood" ? int(last - first) : 0;
+		++groups;
+	});
+
+	assert(*e2.component<Material>() == "wood" && e3.component<Material>().references() == 2U);
+	assert(groups == 2 && wood == 2);
+
+	auto e4 = m.create();
+
+	e4.assign(e1.component<Material>()); // Copies the handle
+	e1.destroy();
+	e3.destroy();
+
+	assert(*e4.component<Material>() == "stone" && e4.component<Material>().references() == 1U);
+	assert(e2.component<Material>().references() == 1U && m.count<Material>() == 2U);
+
+	auto e5 = m.create();
+	auto thrown = false;
+
+	try {
+		e5.replace<Material>(std::string("iron")); // Not owned
+	}
+	catch (const std::runtime_error&) {
+		thrown = true;
+	}
+
+	assert(thrown && !e5.has<Material>() && m.peek<Material>()->distinct() == 2U);
+}
+
+void tiering() {
+	cs::EntityManager m;
+
+	auto ids = std::vector<cs::EntityId>();
+
+	m.tier<Position>(1U); // Frozen as soon as they aren't accessed for one freeze
+
+	for (auto i = 0; i < 100; ++i) {
+		ids.push_back(m.create<Position>(i, i).id());
+	}
+
+	auto hot = m.footprint<Position>();
+	auto frozen = m.freeze<Position>();
+	auto cold = m.footprint<Position>();
+	auto visited = 0;
+
+	m.each<Position>([&visited](auto e, Position& p) {
+		++visited;
+	});
+
+	assert(frozen == 100U && cold.cold > 0U && cold.dense < hot.dense);
+	assert(m.count<Position>() == 100U && visited == 100);
+	assert(m.component<Position>(ids[7]).x == 7);
+
+	m.replace<Position>(ids[8], 80, 80);
+	m.destroy(ids[9]);
+
+	assert(m.component<Position>(ids[8]).x == 80 && m.count<Position>() == 99U);
+}
+
+void buffering() {
+	cs::EntityManager m;
+
+	m.buffer<Position>();
+
+	auto e1 = m.create<Position>(1, 1);
+	const auto& front = m.front<Position>();
+
+	assert(front.size() == 0U); // Nothing published yet
+
+	m.swap();
+	e1.component<Position>().x = 2;
+
+	assert(front.get(e1.id()).x == 1); // Readers see the last published frame
+
+	m.swap<Position>();
+	e1.destroy();
+
+	assert(front.get(e1.id()).x == 2);
+
+	m.swap();
+
+	assert(!front.contains(e1.id()) && front.size() == 0U);
+}
+
+void replication() {
+	cs::EntityManager source;
+	cs::EntityManager target;
+	cs::EntityManager other;
+
+	std::ostringstream stream;
+	cs::StreamSink sink(stream);
+	cs::ChangeLog log(sink);
+
+	source.record(&log);
+	source.track<Position>(1U);
+
+	auto e1 = source.create<Position>(1, 2);
+	auto e2 = source.create<Position>(3, 4);
+
+	e1.replace<Position>(5, 6);
+	e2.destroy();
+	log.flush();
+	source.record(nullptr);
+
+	auto bytes = stream.str();
+	auto data = reinterpret_cast<const std::uint8_t*>(bytes.data());
+
+	cs::ChangeReplay replay(target);
+	cs::ChangeReplay mismatch(other);
+
+	target.create(); // Identifiers differ from the ones of the source
+	replay.bind<Position>(1U);
+	mismatch.bind<int>(1U); // Not the size of the component logged
+
+	auto used = replay.apply(data, bytes.size());
+	auto id = replay.translate(e1.id());
+	auto thrown = false;
+
+	try {
+		mismatch.apply(data, bytes.size());
+	}
+	catch (const std::runtime_error&) {
+		thrown = true;
+	}
+
+	assert(used == bytes.size() && replay.tick() == 1U);
+	assert(id != e1.id() && target.component<Position>(id).x == 5);
+	assert(target.size() == 2U && target.count<Position>() == 1U);
+	assert(thrown);
+}
+
+void definition() {
+	cs::EntityManager m;
+
+	auto name = cs::ComponentType::of<std::string>();
+	auto speed = cs::ComponentType(sizeof(float), alignof(float));
+	auto invalid = cs::ComponentType(sizeof(float), 3U);
+	auto thrown = false;
+
+	m.define(name);
+	m.define(speed);
+
+	try {
+		m.define(invalid); // Not a power of two
+	}
+	catch (const std::runtime_error&) {
+		thrown = true;
+	}
+
+	auto e1 = m.create<int>(1);
+	auto e2 = m.create<int>(2);
+	auto label = std::string("first");
+	auto value = 3.f;
+	auto visited = 0;
+
+	m.emplace(e1.id(), name.id, &label);
+	m.emplace(e1.id(), speed.id, &value);
+	m.emplace(e2.id(), speed.id, &value);
+
+	m.view({ name.id, speed.id }).each([&visited](cs::EntityId e, void** components) {
+		visited += *static_cast<std::string*>(components[0]) == "first" ? 1 : 0;
+	});
+
+	auto first = m.view({ speed.id, name.id }).begin(); // Outlives the view
+	auto last = m.view({ speed.id, name.id }).end();
+
+	assert(*first == e1.id() && ++first == last);
+
+	m.erase(e2.id(), speed.id);
+
+	assert(*static_cast<std::string*>(m.component(e1.id(), name.id)) == "first");
+	assert(*static_cast<float*>(m.component(e1.id(), speed.id)) == 3.f);
+	assert(visited == 1 && !m.contains(e2.id(), speed.id));
+	assert(thrown);
+}
+
+void rollback() {
+	cs::EntityManager m;
+	cs::Rollback r(m, 2U);
+
+	auto e1 = m.create<int>(1);
+	auto e2 = m.create<int>(2);
+
+	m.tier<int>(1U);
+
+	auto t0 = r.save();
+
+	m.freeze<int>();
+	r.restore(t0); // Frozen since the tick
+	e2.remove<int>();
+	e2.assign<int>(7);
+
+	assert(m.component<int>(e1.id()) == 1 && m.component<int>(e2.id()) == 7);
+	assert(m.count<int>() == 2U);
+
+	m.freeze<int>();
+
+	auto t1 = r.save(); // Frozen when saved
+
+	e1.replace<int>(10);
+	e2.destroy();
+
+	auto e3 = m.create<float>(3.f);
+
+	r.restore(t1);
+
+	assert(m.component<int>(e1.id()) == 1 && m.component<int>(e2.id()) == 7);
+	assert(!m.valid(e3.id()) && m.count<float>() == 0U);
+
+	r.save();
+	r.save();
+
+	auto thrown = false;
+
+	try {
+		r.restore(t0); // Overwritten by the ring
+	}
+	catch (const std::runtime_error&) {
+		thrown = true;
+	}
+
+	assert(thrown && !r.retained(t0));
+
+	cs::EntityManager parent;
+	auto e4 = parent.create<int>(4);
+	auto f = parent.fork();
+	cs::Rollback s(f, 2U);
+
+	auto t2 = s.save(); // Shares the set of the parent
+
+	f.replace<int>(e4.id(), 40);
+	s.restore(t2);
+
+	assert(f.component<int>(e4.id()) == 4 && f.count<int>() == 1U);
+	assert(parent.component<int>(e4.id()) == 4);
+}
+
+void forking() {
+	cs::EntityManager m;
+
+	auto e1 = m.create<int>(1);
+	auto e2 = m.create<int>(2);
+
+	m.create<Position>(3, 3);
+	m.tier<Position>(1U);
+	m.freeze<Position>();
+
+	{
+		auto f = m.fork(); // Shares the sets until it writes them
+
+		f.component<int>(e1.id()) = 10;
+		f.destroy(e2.id());
+		f.each<Position>([](auto e, Position& p) {
+			p.x = 30;
+		});
+
+		assert(f.get<int>(e1.id()) == 10 && !f.valid(e2.id()) && f.count<Position>() == 1U);
+		assert(m.get<int>(e1.id()) == 1 && m.valid(e2.id()) && m.count<Position>() == 1U);
+	}
+
+	assert(m.footprint<Position>().cold > 0U); // Still frozen in the parent
+
+	m.each<Position>([](auto e, Position& p) {
+		assert(p.x == 3);
+	});
+
+	assert(m.size() == 3U && m.count<int>() == 2U);
+}
+
+void resumption() {
+	cs::EntityManager m;
+	cs::ViewCursor cursor;
+
+	for (auto i = 0; i < 10; ++i) {
+		m.create<int>(i);
+	}
+
+	auto sum = 0;
+	auto frames = 2; // The first one and the one completing the pass
+	auto add = [&sum](auto e, int& i) {
+		sum += i;
+	};
+
+	assert(!cursor.each(m.view<int>(), 4U, add)); // Budget of four entities a frame
+
+	m.create<int>(10); // Created between two frames
+
+	while (!cursor.each(m.view<int>(), 4U, add)) {
+		++frames;
+	}
+
+	assert(frames == 3 && sum == 55 && cursor.position() == 0U);
+}
+
+void sharding() {
+	cs::ShardedManager w(2U);
+
+	w.broadcast([](cs::EntityManager& m, std::uint32_t shard) {
+		for (auto i = 0; i < 10; ++i) {
+			m.create<int>(int(shard) + 1);
+		}
+	});
+
+	auto ids = std::vector<cs::EntityId>();
+	auto total = w.reduce<int>(0, [](cs::EntityId, int i) { return i; }, [](int lhs, int rhs) { return lhs + rhs; });
+
+	w.run(0U, [&ids](cs::EntityManager& m) {
+		m.each<int>([&ids](auto e, int& i) {
+			ids.push_back(e);
+		});
+	});
+
+	auto moved = w.migrate(0U, ids.begin(), ids.begin() + 5, 1U);
+	auto thrown = false;
+
+	try {
+		w.broadcast([](cs::EntityManager& m, std::uint32_t shard) {
+			if (shard == 1U) {
+				throw std::runtime_error("Failed");
+			}
+		});
+	}
+	catch (const std::runtime_error&) {
+		thrown = true;
+	}
+
+	assert(w.size() == 20U && total == 30);
+	assert(w.shard(0U).size() == 5U && w.shard(1U).get<int>(moved[0]) == 1);
+	assert(thrown);
+}
+
+void spawning() {
+	cs::EntityManager m;
+
+	auto e1 = m.create<int>(0);
+	auto e2 = m.create<int>(0);
+
+	e1.destroy(); // Recycled by the spawner
+
+	{
+		cs::Spawner s(m);
+
+		s.reserve(100U);
+
+		auto thrown = false;
+		auto threads = std::vector<std::thread>();
+
+		try {
+			m.fork(); // Reserved entities can't be shared
+		}
+		catch (const std::runtime_error&) {
+			thrown = true;
+		}
+
+		auto other = cs::EntityManager();
+		auto ids = std::vector<cs::EntityId>(1U, other.create<int>(5).id());
+		auto rejected = 0;
+
+		try {
+			other.merge(std::move(m)); // Nor handed over
+		}
+		catch (const std::runtime_error&) {
+			++rejected;
+		}
+
+		try {
+			other.migrate(ids.begin(), ids.end(), m); // Clones would take reserved slots
+		}
+		catch (const std::runtime_error&) {
+			++rejected;
+		}
+
+		for (auto t = 0; t < 4; ++t) {
+			threads.emplace_back([&s, t]() {
+				for (auto i = 0; i < 25; ++i) {
+					s.assign<int>(s.spawn(), t + 1);
+				}
+			});
+		}
+
+		for (auto& thread : threads) {
+			thread.join();
+		}
+
+		assert(thrown && m.size() == 1U);
+		assert(rejected == 2 && other.size() == 1U);
+
+		s.commit();
+	}
+
+	auto sum = 0;
+
+	m.each<int>([&sum](auto e, int& i) {
+		sum += i;
+	});
+
+	assert(m.size() == 101U && m.count<int>() == 101U && sum == 250);
+	assert(m.valid(e2.id()) && m.create().id() == 101U);
+}
+
+void messaging() {
+	cs::EntityManager m;
+	cs::EventReader r1;
+	cs::EventReader r2;
+
+	auto& hits = m.channel<Position>();
+	auto threads = std::vector<std::thread>();
+
+	for (auto t = 0; t < 4; ++t) {
+		threads.emplace_back([&hits, t]() {
+			for (auto i = 0; i < 10; ++i) {
+				hits.publish(Position(t, i));
+			}
+		});
+	}
+
+	for (auto& thread : threads) {
+		thread.join();
+	}
+
+	auto ordered = true;
+	auto last = std::vector<int>(4, -1);
+
+	assert(hits.read(r1, [](const Position&) {}) == 0U); // Delivered on flush only
+
+	m.flush();
+
+	auto read = hits.read(r1, [&ordered, &last](const Position& p) {
+		ordered = ordered && p.y == last[p.x] + 1;
+		last[p.x] = p.y;
+	});
+
+	assert(read == 40U && ordered && hits.read(r1, [](const Position&) {}) == 0U);
+
+	m.flush();
+
+	assert(hits.size() == 0U && hits.read(r2, [](const Position&) {}) == 0U);
+}
+
+void clearing() {
+	cs::EntityManager m;
+
+	auto ids = std::vector<cs::EntityId>();
+
+	for (auto i = 0; i < 10; ++i) {
+		ids.push_back(m.create<Position>(i, i).id());
+		m.assign<int>(ids.back(), i);
+	}
+
+	m.attach(ids[1], ids[0]);
+	m.reset<Position>();
+
+	assert(m.count<Position>() == 0U && m.count<int>() == 10U && m.size() == 10U);
+
+	m.reset();
+
+	auto e1 = m.create<int>(1);
+
+	assert(m.size() == 1U && m.count<int>() == 1U && m.hierarchy().size() == 0U);
+	assert((e1.id() & cs::Entity::ID_MASK) == 0U && !m.valid(ids[0]));
+}
+
+void indexing() {
+	cs::EntityManager m;
+	cs::HashIndex<Position, int> horizontal(&Position::x);
+	cs::OrderedIndex<Position, int> vertical(&Position::y);
+
+	auto e1 = m.create<Position>(1, 10);
+	auto e2 = m.create<Position>(2, 20);
+	auto e3 = m.create<Position>(2, 30);
+
+	m.observe(horizontal);
+	m.observe(vertical);
+
+	assert(horizontal.find(1) == e1.id() && horizontal.count(2) == 2U && horizontal.find(3) == cs::Entity::INVALID);
+	assert(vertical.range(10, 30).size() == 2U && vertical.above(20).size() == 1U && vertical.below(20)[0] == e1.id());
+
+	e1.replace<Position>(3, 40);
+	e2.destroy();
+
+	assert(horizontal.find(1) == cs::Entity::INVALID && horizontal.find(3) == e1.id() && horizontal.count(2) == 1U);
+	assert(vertical.above(30).size() == 1U && vertical.above(30)[0] == e1.id() && !vertical.contains(e2.id()));
+
+	m.reset<Position>();
+
+	assert(horizontal.empty() && vertical.empty() && !horizontal.contains(e3.id()));
+
+	m.unobserve(horizontal);
+	m.unobserve(vertical);
+}
+
 void iteration(cs::EntityManager& m) {
 	m.each([](cs::Entity e) {
 		printf("Iterating entity %d (v%d)...\n", e.id(), e.version());
@@ -215,6 +1046,7 @@ int main()
 	assignment(m);
 	replacement(m);
 	accomodation(m);
+	emplacement(m);
 	resetion(m);
 	remotion(m);
 	checkup(m);
@@ -222,6 +1054,30 @@ int main()
 	sizes();
 	capacities();
 	emptyness();
+	hierarchy();
+	merging();
+	instancing();
+	stability();
+	locality();
+	validation();
+	accounting();
+	profiling();
+	versioning();
+	ranges();
+	reduction();
+	sharing();
+	tiering();
+	buffering();
+	replication();
+	definition();
+	rollback();
+	forking();
+	resumption();
+	sharding();
+	spawning();
+	messaging();
+	clearing();
+	indexing();
 	components(m);
 	//iteration(m);
 
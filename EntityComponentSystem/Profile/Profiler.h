@@ -0,0 +1,106 @@
+#ifndef PROFILE_PROFILER_H
+#define PROFILE_PROFILER_H
+
+#include <mutex>
+#include <memory>
+#include <vector>
+#include <string>
+#include <cstdint>
+
+#ifndef CS_PROFILE_CAPACITY
+#define CS_PROFILE_CAPACITY 16384 // Samples retained per thread
+#endif
+
+#ifdef CS_PROFILE
+#define CS_PROFILE_SCOPE(name) cs::ProfileScope csProfileScope(name)
+#define CS_PROFILE_COUNT(amount) csProfileScope.add(std::uint32_t(amount))
+#else
+#define CS_PROFILE_SCOPE(name)
+#define CS_PROFILE_COUNT(amount)
+#endif
+
+namespace cs
+{
+	/**
+	* @brief Timing of a single profiled scope.
+	*/
+	struct ProfileSample
+	{
+		const char* name;
+		std::uint64_t start; // Nanoseconds since the first sample of the process
+		std::uint64_t duration; // Nanoseconds
+		std::uint32_t count; // Entities processed within the scope
+	};
+
+	/**
+	* @brief Frame profiler.
+	*
+	* Samples are recorded into a ring buffer owned by the recording thread, so
+	* threads never contend with each other. Once a buffer is full the oldest
+	* samples are overwritten.<br/>
+	* Scopes are usually recorded through the `CS_PROFILE_SCOPE` macro, which
+	* compiles to nothing unless `CS_PROFILE` is defined. The library itself
+	* instruments iterations, creation and destruction of entities, sorting and
+	* bulk operations.
+	*
+	* @note
+	* Names of the scopes aren't copied nor escaped. Use string literals.
+	*/
+	class Profiler final
+	{
+	public:
+		static void record(const char* name, std::uint64_t start, std::uint64_t duration, std::uint32_t count);
+		static std::uint64_t now();
+		static bool dump(const std::string& path);
+		static void clear();
+
+	private:
+		struct Buffer
+		{
+			std::mutex mutex; // Uncontended unless a dump is in progress
+			std::uint32_t thread;
+			std::uint32_t head;
+			std::vector<ProfileSample> samples;
+		};
+
+		struct Registry
+		{
+			std::mutex mutex;
+			std::vector<std::shared_ptr<Buffer>> buffers; // Outlive their threads
+		};
+
+		static Registry& registry();
+		static Buffer& local();
+	};
+
+	/**
+	* @brief Records the time spent within a scope.
+	*/
+	class ProfileScope final
+	{
+	public:
+		explicit ProfileScope(const char* name)
+			: name(name)
+			, count(0U)
+			, start(Profiler::now())
+		{}
+
+		ProfileScope(const ProfileScope&) = delete;
+		ProfileScope& operator=(const ProfileScope&) = delete;
+
+		~ProfileScope() {
+			Profiler::record(name, start, Profiler::now() - start, count);
+		}
+
+		void add(std::uint32_t amount) {
+			count += amount;
+		}
+
+	private:
+		const char* name;
+		std::uint32_t count;
+		std::uint64_t start;
+	};
+}
+
+#endif
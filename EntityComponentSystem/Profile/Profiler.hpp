@@ -0,0 +1,116 @@
+#ifndef PROFILE_PROFILER_IMPL
+#define PROFILE_PROFILER_IMPL
+
+#include <chrono>
+#include <fstream>
+#include "Profiler.h"
+
+namespace cs
+{
+	void Profiler::record(const char* name, std::uint64_t start, std::uint64_t duration, std::uint32_t count) {
+		auto& buffer = local();
+		std::lock_guard<std::mutex> lock(buffer.mutex);
+
+		if (buffer.samples.size() < CS_PROFILE_CAPACITY) {
+			buffer.samples.push_back(ProfileSample{ name, start, duration, count });
+		}
+		else {
+			buffer.samples[buffer.head] = ProfileSample{ name, start, duration, count };
+		}
+
+		buffer.head = (buffer.head + 1U) % CS_PROFILE_CAPACITY;
+	}
+
+	/**
+	* @brief Returns the nanoseconds elapsed since the first call.
+	*/
+	std::uint64_t Profiler::now() {
+		using Clock = std::chrono::steady_clock;
+		static const auto origin = Clock::now();
+		return std::uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - origin).count());
+	}
+
+	/**
+	* @brief Writes the samples of all the threads to a file, in Chrome trace format.
+	*
+	* The file can be loaded by `chrome://tracing` or Perfetto. Each scope
+	* becomes a complete event, the number of entities it processed is stored
+	* among its arguments.
+	*
+	* @return True if the file has been written, false otherwise.
+	*/
+	bool Profiler::dump(const std::string& path) {
+		std::ofstream file(path, std::ios::out | std::ios::trunc);
+
+		if (!file) {
+			return false;
+		}
+
+		auto& shared = registry();
+		std::lock_guard<std::mutex> guard(shared.mutex);
+		auto separator = "";
+
+		file << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+		file.setf(std::ios::fixed);
+		file.precision(3);
+
+		for (auto& buffer : shared.buffers) {
+			std::lock_guard<std::mutex> lock(buffer->mutex);
+			const auto size = std::uint32_t(buffer->samples.size());
+			const auto first = (size < CS_PROFILE_CAPACITY) ? 0U : buffer->head; // Oldest sample first
+
+			for (std::uint32_t i = 0U; i < size; ++i) {
+				const auto& sample = buffer->samples[(first + i) % size];
+
+				file << separator
+					<< "{\"name\":\"" << sample.name << "\",\"cat\":\"cs\",\"ph\":\"X\",\"pid\":0,\"tid\":" << buffer->thread
+					<< ",\"ts\":" << double(sample.start) / 1000.0
+					<< ",\"dur\":" << double(sample.duration) / 1000.0
+					<< ",\"args\":{\"entities\":" << sample.count << "}}";
+
+				separator = ",";
+			}
+		}
+
+		file << "]}";
+
+		return bool(file);
+	}
+
+	/**
+	* @brief Discards the samples recorded so far by all the threads.
+	*/
+	void Profiler::clear() {
+		auto& shared = registry();
+		std::lock_guard<std::mutex> guard(shared.mutex);
+
+		for (auto& buffer : shared.buffers) {
+			std::lock_guard<std::mutex> lock(buffer->mutex);
+			buffer->samples.clear();
+			buffer->head = 0U;
+		}
+	}
+
+	Profiler::Registry& Profiler::registry() {
+		static Registry registry;
+		return registry;
+	}
+
+	Profiler::Buffer& Profiler::local() {
+		thread_local std::shared_ptr<Buffer> buffer;
+
+		if (!buffer) {
+			auto& shared = registry();
+			std::lock_guard<std::mutex> guard(shared.mutex);
+
+			buffer = std::make_shared<Buffer>();
+			buffer->thread = std::uint32_t(shared.buffers.size());
+			buffer->head = 0U;
+			shared.buffers.push_back(buffer);
+		}
+
+		return *buffer;
+	}
+}
+
+#endif
@@ -0,0 +1,105 @@
+#ifndef REPLICATION_CHANGE_LOG_H
+#define REPLICATION_CHANGE_LOG_H
+
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include "ChangeSink.h"
+#include "../Entity/EntityTraits.h"
+#include "../Component/Container/ComponentListener.h"
+
+namespace cs
+{
+	template <typename>
+	class ComponentCollection;
+
+	/**
+	* @brief Kinds of records of a change log.
+	*/
+	enum class Change : std::uint8_t
+	{
+		Create, // Identifier
+		Destroy, // Identifier
+		Add, // Tag, identifier, size and bytes of the component
+		Replace, // Tag, identifier, size and bytes of the component
+		Remove, // Tag, identifier
+		Clear // Tag
+	};
+
+	/**
+	* @brief Binary log of the changes made to an entity manager.
+	*
+	* Attach it with `EntityManager::record` and pick the types of components to
+	* replicate with `EntityManager::track`. Records are accumulated in memory and
+	* handed over to the sink as a single batch by `flush`, usually once per
+	* tick. Batches are made of a header (tick and size of the records, both
+	* `std::uint64_t`) followed by the records, see Change.
+	*
+	* @note
+	* Integers and components are written in native byte order, as they are in
+	* memory. Readers must run on the same architecture and use the same width of
+	* identifiers (see `CS_ENTITY_64`).
+	*
+	* @warning
+	* Components modified in place aren't recorded, see ComponentListener.
+	* The log must outlive the tracked sets, or be detached first.
+	*/
+	class ChangeLog final
+	{
+	public:
+		explicit ChangeLog(ChangeSink& sink);
+		ChangeLog(const ChangeLog&) = delete;
+
+		ChangeLog& operator=(const ChangeLog&) = delete;
+
+		void created(EntityId id);
+		void destroyed(EntityId id);
+
+		template <typename Component>
+		ComponentListener<Component>& track(ComponentCollection<Component>& set, std::uint32_t tag);
+		void detach();
+
+		void flush();
+		std::uint64_t tick() const;
+		std::size_t pending() const;
+
+	private:
+		class Tracking
+		{
+		public:
+			virtual ~Tracking() = default;
+		};
+
+		template <typename Component>
+		class Tracker final : public Tracking, public ComponentListener<Component>
+		{
+		public:
+			Tracker(ChangeLog& log, ComponentCollection<Component>& set, std::uint32_t tag);
+			~Tracker();
+
+			void added(EntityId value, const Component& component) override;
+			void replaced(EntityId value, const Component& component) override;
+			void removed(EntityId value, const Component& component) override;
+			void cleared() override;
+
+		private:
+			ChangeLog& log;
+			ComponentCollection<Component>& set;
+			std::uint32_t tag;
+		};
+
+		template <typename Type>
+		void put(const Type& value);
+		void put(const void* data, std::size_t size);
+
+	private:
+		ChangeSink& sink;
+		std::uint64_t ticks = 0U;
+		std::vector<std::uint8_t> records; // Current batch, header excluded
+		std::vector<std::uint8_t> batch; // Header and records, kept around to spare allocations
+		std::vector<std::unique_ptr<Tracking>> trackers;
+	};
+}
+
+#endif
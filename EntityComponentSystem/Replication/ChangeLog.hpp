@@ -0,0 +1,144 @@
+#ifndef REPLICATION_CHANGE_LOG_IMPL
+#define REPLICATION_CHANGE_LOG_IMPL
+
+#include <cstring>
+#include <type_traits>
+#include "ChangeLog.h"
+#include "ChangeSink.hpp"
+#include "../Component/Container/ComponentCollection.hpp"
+
+namespace cs
+{
+	ChangeLog::ChangeLog(ChangeSink& sink)
+		: sink(sink)
+	{}
+
+	void ChangeLog::created(EntityId id) {
+		put(Change::Create);
+		put(id);
+	}
+
+	void ChangeLog::destroyed(EntityId id) {
+		put(Change::Destroy);
+		put(id);
+	}
+
+	/**
+	* @brief Creates a listener that records the changes made to a set.
+	*
+	* The listener still has to be registered to the set, see
+	* `EntityManager::observe`.
+	*
+	* @param tag Identifier of the type of the components, shared with the
+	* readers of the log (`ComponentFamily` identifiers aren't stable across
+	* processes).
+	*/
+	template <typename Component>
+	ComponentListener<Component>& ChangeLog::track(ComponentCollection<Component>& set, std::uint32_t tag) {
+		static_assert(std::is_trivially_copyable<Component>::value, "Only trivially copyable components can be recorded");
+
+		auto tracker = std::make_unique<Tracker<Component>>(*this, set, tag);
+		auto& listener = *tracker;
+
+		trackers.push_back(std::move(tracker));
+
+		return listener;
+	}
+
+	/**
+	* @brief Stops recording the changes made to the tracked sets.
+	*/
+	void ChangeLog::detach() {
+		trackers.clear();
+	}
+
+	/**
+	* @brief Hands the records accumulated so far over to the sink as a single
+	* batch and starts the next tick.
+	*
+	* Empty ticks are written as well, readers can rely on them as heartbeats.
+	*/
+	void ChangeLog::flush() {
+		const auto size = std::uint64_t(records.size());
+
+		batch.resize(sizeof(ticks) + sizeof(size));
+		std::memcpy(batch.data(), &ticks, sizeof(ticks));
+		std::memcpy(batch.data() + sizeof(ticks), &size, sizeof(size));
+		batch.insert(batch.end(), records.begin(), records.end());
+
+		sink.write(batch.data(), batch.size());
+		sink.flush();
+
+		records.clear();
+		++ticks;
+	}
+
+	/**
+	* @brief Returns the tick of the batch currently accumulated.
+	*/
+	std::uint64_t ChangeLog::tick() const {
+		return ticks;
+	}
+
+	/**
+	* @brief Returns the size in bytes of the records not flushed yet.
+	*/
+	std::size_t ChangeLog::pending() const {
+		return records.size();
+	}
+
+	template <typename Type>
+	void ChangeLog::put(const Type& value) {
+		put(&value, sizeof(Type));
+	}
+
+	void ChangeLog::put(const void* data, std::size_t size) {
+		const auto bytes = static_cast<const std::uint8_t*>(data);
+		records.insert(records.end(), bytes, bytes + size);
+	}
+
+	template <typename Component>
+	ChangeLog::Tracker<Component>::Tracker(ChangeLog& log, ComponentCollection<Component>& set, std::uint32_t tag)
+		: log(log)
+		, set(set)
+		, tag(tag)
+	{}
+
+	template <typename Component>
+	ChangeLog::Tracker<Component>::~Tracker() {
+		set.unlisten(this);
+	}
+
+	template <typename Component>
+	void ChangeLog::Tracker<Component>::added(EntityId value, const Component& component) {
+		log.put(Change::Add);
+		log.put(tag);
+		log.put(value);
+		log.put(std::uint32_t(sizeof(Component)));
+		log.put(component);
+	}
+
+	template <typename Component>
+	void ChangeLog::Tracker<Component>::replaced(EntityId value, const Component& component) {
+		log.put(Change::Replace);
+		log.put(tag);
+		log.put(value);
+		log.put(std::uint32_t(sizeof(Component)));
+		log.put(component);
+	}
+
+	template <typename Component>
+	void ChangeLog::Tracker<Component>::removed(EntityId value, const Component&) {
+		log.put(Change::Remove);
+		log.put(tag);
+		log.put(value);
+	}
+
+	template <typename Component>
+	void ChangeLog::Tracker<Component>::cleared() {
+		log.put(Change::Clear);
+		log.put(tag);
+	}
+}
+
+#endif
@@ -0,0 +1,63 @@
+#ifndef REPLICATION_CHANGE_REPLAY_H
+#define REPLICATION_CHANGE_REPLAY_H
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include "ChangeLog.h"
+#include "../Entity/EntityTraits.h"
+
+namespace cs
+{
+	class EntityManager;
+
+	/**
+	* @brief Applies change logs to an entity manager.
+	*
+	* Entities created by the log are created anew in the target manager,
+	* identifiers are translated on the fly (see `translate`). Components are
+	* applied for the tags bound with `bind` only, the others are skipped.
+	* Clearing a set in the source clears the whole set in the target.
+	*
+	* @note
+	* A replay must see all the batches of a log, in order, to keep its
+	* translation table right.
+	*
+	* @note
+	* Records that run past their batch, or whose component doesn't have the
+	* size of the type bound to their tag, throw `std::runtime_error`. Records
+	* before them in the same batch have been applied already.
+	*/
+	class ChangeReplay final
+	{
+	public:
+		explicit ChangeReplay(EntityManager& target);
+
+		template <typename Component>
+		void bind(std::uint32_t tag);
+
+		std::size_t apply(const std::uint8_t* data, std::size_t size);
+		EntityId translate(EntityId id) const;
+		std::uint64_t tick() const;
+
+	private:
+		using Handler = void(*)(EntityManager&, Change, EntityId, const std::uint8_t*, std::uint32_t);
+
+		template <typename Component>
+		static void handle(EntityManager& target, Change change, EntityId id, const std::uint8_t* bytes, std::uint32_t length);
+
+		void replay(const std::uint8_t* data, std::size_t size);
+
+		template <typename Type>
+		static Type get(const std::uint8_t* data, std::size_t size, std::size_t& offset);
+
+	private:
+		EntityManager& target;
+		std::uint64_t ticks = 0U;
+		std::vector<EntityId> table; // Target identifiers, indexed by source entity
+		std::unordered_map<std::uint32_t, Handler> handlers;
+	};
+}
+
+#endif
@@ -0,0 +1,149 @@
+#ifndef REPLICATION_CHANGE_REPLAY_IMPL
+#define REPLICATION_CHANGE_REPLAY_IMPL
+
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include "ChangeReplay.h"
+#include "../Entity/EntityManager.hpp"
+
+namespace cs
+{
+	ChangeReplay::ChangeReplay(EntityManager& target)
+		: target(target)
+	{}
+
+	/**
+	* @brief Applies the records with the given tag to components of the given type.
+	*/
+	template <typename Component>
+	void ChangeReplay::bind(std::uint32_t tag) {
+		static_assert(std::is_trivially_copyable<Component>::value, "Only trivially copyable components can be replayed");
+		handlers[tag] = &ChangeReplay::handle<Component>;
+	}
+
+	/**
+	* @brief Applies all the complete batches at the beginning of a buffer.
+	*
+	* Streams can be fed as data comes in: keep the bytes past the returned
+	* amount and pass them again along with the next chunk.
+	*
+	* @return The number of bytes consumed.
+	*/
+	std::size_t ChangeReplay::apply(const std::uint8_t* data, std::size_t size) {
+		const auto header = sizeof(std::uint64_t) * 2U;
+		auto offset = std::size_t(0);
+
+		while (size - offset >= header) {
+			auto position = offset;
+			const auto tick = get<std::uint64_t>(data, size, position);
+			const auto length = get<std::uint64_t>(data, size, position);
+
+			if (size - position < length) {
+				break;
+			}
+
+			replay(data + position, std::size_t(length));
+			ticks = tick + 1U;
+			offset = position + std::size_t(length);
+		}
+
+		return offset;
+	}
+
+	/**
+	* @brief Translates an identifier of the source manager, `Entity::INVALID`
+	* if the entity isn't alive according to the log.
+	*/
+	EntityId ChangeReplay::translate(EntityId id) const {
+		const auto entity = id & Entity::ID_MASK;
+		return entity < table.size() ? table[entity] : Entity::INVALID;
+	}
+
+	/**
+	* @brief Returns the tick of the next batch expected.
+	*/
+	std::uint64_t ChangeReplay::tick() const {
+		return ticks;
+	}
+
+	template <typename Component>
+	void ChangeReplay::handle(EntityManager& target, Change change, EntityId id, const std::uint8_t* bytes, std::uint32_t length) {
+		if (change == Change::Clear) {
+			target.reset<Component>();
+		}
+		else if (change == Change::Remove) {
+			target.reset<Component>(id);
+		}
+		else if (length != sizeof(Component)) {
+			throw std::runtime_error("Corrupted change log");
+		}
+		else {
+			typename std::aligned_storage<sizeof(Component), alignof(Component)>::type buffer;
+
+			std::memcpy(&buffer, bytes, sizeof(Component));
+			target.accomodate(id, reinterpret_cast<const Component&>(buffer));
+		}
+	}
+
+	void ChangeReplay::replay(const std::uint8_t* data, std::size_t size) {
+		auto offset = std::size_t(0);
+
+		while (offset < size) {
+			const auto change = get<Change>(data, size, offset);
+
+			if (change == Change::Create || change == Change::Destroy) {
+				const auto entity = get<EntityId>(data, size, offset) & Entity::ID_MASK;
+
+				if (entity >= table.size()) {
+					table.resize(entity + 1U, Entity::INVALID);
+				}
+
+				if (change == Change::Create) {
+					table[entity] = target.create().id();
+				}
+				else if (table[entity] != Entity::INVALID) {
+					target.destroy(table[entity]);
+					table[entity] = Entity::INVALID;
+				}
+			}
+			else if (change == Change::Clear) {
+				const auto handler = handlers.find(get<std::uint32_t>(data, size, offset));
+
+				if (handler != handlers.end()) {
+					handler->second(target, change, Entity::INVALID, nullptr, 0U);
+				}
+			}
+			else {
+				const auto tag = get<std::uint32_t>(data, size, offset);
+				const auto id = translate(get<EntityId>(data, size, offset));
+				const auto length = change == Change::Remove ? std::uint32_t(0) : get<std::uint32_t>(data, size, offset);
+				const auto handler = handlers.find(tag);
+
+				if (size - offset < length) {
+					throw std::runtime_error("Corrupted change log");
+				}
+
+				if (handler != handlers.end() && id != Entity::INVALID) {
+					handler->second(target, change, id, data + offset, length);
+				}
+
+				offset += length;
+			}
+		}
+	}
+
+	template <typename Type>
+	Type ChangeReplay::get(const std::uint8_t* data, std::size_t size, std::size_t& offset) {
+		if (size - offset < sizeof(Type)) {
+			throw std::runtime_error("Corrupted change log");
+		}
+
+		Type value;
+		std::memcpy(&value, data + offset, sizeof(Type));
+		offset += sizeof(Type);
+		return value;
+	}
+}
+
+#endif
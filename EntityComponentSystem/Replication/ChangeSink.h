@@ -0,0 +1,62 @@
+#ifndef REPLICATION_CHANGE_SINK_H
+#define REPLICATION_CHANGE_SINK_H
+
+#include <string>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <fstream>
+
+namespace cs
+{
+	/**
+	* @brief Destination of the batches of a ChangeLog.
+	*
+	* Implement it to ship change logs over any transport (as an example, a
+	* local socket). Each batch is handed over as a whole with a single call to
+	* `write`.
+	*/
+	class ChangeSink
+	{
+	public:
+		virtual ~ChangeSink() = default;
+
+		virtual void write(const std::uint8_t* data, std::size_t size) = 0;
+		virtual void flush() {}
+	};
+
+	/**
+	* @brief Sink writing to an output stream owned by someone else.
+	*/
+	class StreamSink final : public ChangeSink
+	{
+	public:
+		explicit StreamSink(std::ostream& stream);
+
+		void write(const std::uint8_t* data, std::size_t size) override;
+		void flush() override;
+
+	private:
+		std::ostream& stream;
+	};
+
+	/**
+	* @brief Sink writing to a file, truncated when the sink is created.
+	*
+	* Named pipes can be opened by path as well.
+	*/
+	class FileSink final : public ChangeSink
+	{
+	public:
+		explicit FileSink(const std::string& path);
+
+		void write(const std::uint8_t* data, std::size_t size) override;
+		void flush() override;
+		bool good() const;
+
+	private:
+		std::ofstream file;
+	};
+}
+
+#endif
@@ -0,0 +1,42 @@
+#ifndef REPLICATION_CHANGE_SINK_IMPL
+#define REPLICATION_CHANGE_SINK_IMPL
+
+#include <stdexcept>
+#include "ChangeSink.h"
+
+namespace cs
+{
+	StreamSink::StreamSink(std::ostream& stream)
+		: stream(stream)
+	{}
+
+	void StreamSink::write(const std::uint8_t* data, std::size_t size) {
+		if (!stream.write(reinterpret_cast<const char*>(data), std::streamsize(size))) {
+			throw std::runtime_error("Unable to write the change log");
+		}
+	}
+
+	void StreamSink::flush() {
+		stream.flush();
+	}
+
+	FileSink::FileSink(const std::string& path)
+		: file(path, std::ios::out | std::ios::binary | std::ios::trunc)
+	{}
+
+	void FileSink::write(const std::uint8_t* data, std::size_t size) {
+		if (!file.write(reinterpret_cast<const char*>(data), std::streamsize(size))) {
+			throw std::runtime_error("Unable to write the change log");
+		}
+	}
+
+	void FileSink::flush() {
+		file.flush();
+	}
+
+	bool FileSink::good() const {
+		return file.good();
+	}
+}
+
+#endif
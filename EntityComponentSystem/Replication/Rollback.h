@@ -0,0 +1,72 @@
+#ifndef REPLICATION_ROLLBACK_H
+#define REPLICATION_ROLLBACK_H
+
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include "../Entity/EntityTraits.h"
+#include "../Component/Container/Hierarchy.h"
+
+namespace cs
+{
+	class EntityManager;
+
+	/**
+	* @brief Ring buffer of snapshots of an entity manager.
+	*
+	* Each `save` records the state of the manager as a new tick, the last
+	* `depth` ticks are retained. Sets that didn't change since the previous
+	* tick (see Collection::revision) aren't copied again, the snapshots share
+	* them. `restore` brings the manager back to a retained tick in place:
+	* only the sets that changed since then are copied back, over the memory
+	* they already own, and the ticks that follow are discarded.
+	*
+	* @note
+	* Components written in place through `EntityManager::get` (or references
+	* kept around) must be flagged with `EntityManager::modify`, or the next
+	* snapshot shares the stale copy.<br/>
+	* Listeners see the restored sets cleared and filled again, so do change
+	* logs, but they miss the restored entities: detach them first. Front
+	* buffers aren't part of the snapshots, cold tiers are brought back by
+	* both `save` and `restore` so that snapshots hold all the components.<br/>
+	* Snapshots of a fork refer to the sets it still shares with its parent
+	* rather than copying them. Restoring one of these sets drops the copy
+	* the fork made since, it reads the set of the parent again.
+	*/
+	class Rollback final
+	{
+	public:
+		Rollback(EntityManager& source, std::uint32_t depth);
+		Rollback(const Rollback&) = delete;
+
+		Rollback& operator=(const Rollback&) = delete;
+
+		std::uint64_t save();
+		void restore(std::uint64_t tick);
+		bool retained(std::uint64_t tick) const;
+		std::uint64_t tick() const;
+
+	private:
+		struct Frame
+		{
+			EntityId next = 0U;
+			std::uint32_t available = 0U;
+			std::vector<EntityId> entities;
+			std::vector<std::shared_ptr<Collection>> copies; // Hierarchy first, then sets by identifier
+			std::vector<std::uint64_t> revisions; // Revisions of the live sets the copies match
+		};
+
+		std::uint32_t collections() const;
+		Collection* collection(std::uint32_t index) const;
+		bool shared(std::uint32_t index) const;
+
+		static bool borrowed(const std::shared_ptr<Collection>& copy);
+
+	private:
+		EntityManager& source;
+		std::uint64_t ticks = 0U;
+		std::vector<Frame> frames;
+	};
+}
+
+#endif
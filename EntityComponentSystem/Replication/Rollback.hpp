@@ -0,0 +1,154 @@
+#ifndef REPLICATION_ROLLBACK_IMPL
+#define REPLICATION_ROLLBACK_IMPL
+
+#include <stdexcept>
+#include "Rollback.h"
+#include "../Entity/EntityManager.hpp"
+
+namespace cs
+{
+	Rollback::Rollback(EntityManager& source, std::uint32_t depth)
+		: source(source)
+		, frames(depth)
+	{
+		if (!depth) {
+			throw std::runtime_error("Rollback depth must be positive");
+		}
+	}
+
+	/**
+	* @brief Records the current state of the manager as a new tick.
+	*
+	* The slot of the oldest tick is reused once the buffer is full, copies
+	* that aren't shared with other ticks are overwritten in place.
+	*
+	* @return The tick just recorded.
+	*/
+	std::uint64_t Rollback::save() {
+		CS_PROFILE_SCOPE("Rollback::save");
+		auto& frame = frames[ticks % frames.size()];
+		const auto previous = ticks ? &frames[(ticks - 1U) % frames.size()] : nullptr;
+		const auto count = collections();
+
+		frame.next = source.next;
+		frame.available = source.available;
+		frame.entities = source.entities;
+		frame.copies.resize(count);
+		frame.revisions.resize(count);
+
+		for (std::uint32_t i = 0U; i < count; ++i) {
+			const auto live = collection(i);
+			auto& copy = frame.copies[i];
+
+			if (!live) {
+				copy = nullptr;
+				frame.revisions[i] = 0U;
+				continue;
+			}
+
+			if (shared(i)) {
+				// The parent stays untouched, refer to its set rather than copying it
+				copy = std::shared_ptr<Collection>(std::shared_ptr<Collection>(), live);
+				frame.revisions[i] = live->revision();
+				continue;
+			}
+
+			live->thaw(); // Snapshots hold hot components only
+
+			if (previous && i < previous->copies.size() && previous->copies[i] && !borrowed(previous->copies[i]) && previous->revisions[i] == live->revision()) {
+				copy = previous->copies[i];
+			}
+			else {
+				if (copy.use_count() != 1) { // Shared with other ticks or borrowed
+					copy = std::shared_ptr<Collection>(live->create());
+				}
+
+				copy->mirror(*live);
+			}
+
+			frame.revisions[i] = live->revision();
+		}
+
+		return ticks++;
+	}
+
+	/**
+	* @brief Brings the manager back to a retained tick.
+	*
+	* Sets that haven't changed since the tick are left untouched, sets created
+	* after it are cleared. The tick becomes the latest one.
+	*/
+	void Rollback::restore(std::uint64_t tick) {
+		CS_PROFILE_SCOPE("Rollback::restore");
+
+		if (!retained(tick)) {
+			throw std::runtime_error("Tick out of range");
+		}
+
+		auto& frame = frames[tick % frames.size()];
+
+		for (std::uint32_t i = 0U, count = collections(); i < count; ++i) {
+			const auto live = collection(i);
+
+			// Sets a fork still shares haven't changed since any tick
+			if (live && !shared(i)) {
+				const auto copy = i < frame.copies.size() ? frame.copies[i].get() : nullptr;
+
+				if (i < frame.copies.size() && borrowed(frame.copies[i])) {
+					source.sets[i - 1U].reset(); // The fork reads the set of the parent again
+					continue;
+				}
+
+				// Components frozen since the tick would survive the copy otherwise
+				live->thaw();
+
+				if (!copy) {
+					if (!live->empty()) {
+						live->clear();
+					}
+				}
+				else if (live->revision() != frame.revisions[i]) {
+					live->mirror(*copy);
+					frame.revisions[i] = live->revision(); // The next save shares the copy again
+				}
+			}
+		}
+
+		source.entities = frame.entities;
+		source.next = frame.next;
+		source.available = frame.available;
+		ticks = tick + 1U;
+	}
+
+	/**
+	* @brief Checks whether a tick can still be restored.
+	*/
+	bool Rollback::retained(std::uint64_t tick) const {
+		return tick < ticks && ticks - tick <= frames.size();
+	}
+
+	/**
+	* @brief Returns the tick that the next `save` will record.
+	*/
+	std::uint64_t Rollback::tick() const {
+		return ticks;
+	}
+
+	std::uint32_t Rollback::collections() const {
+		return std::uint32_t(source.sets.size()) + 1U;
+	}
+
+	Collection* Rollback::collection(std::uint32_t index) const {
+		return index ? source.lookup(index - 1U) : &source.tree;
+	}
+
+	bool Rollback::borrowed(const std::shared_ptr<Collection>& copy) {
+		return copy && !copy.use_count(); // Sets of the parent aren't owned
+	}
+
+	bool Rollback::shared(std::uint32_t index) const {
+		return index && !source.sets[index - 1U] && source.lookup(index - 1U);
+	}
+}
+
+#endif
@@ -0,0 +1,37 @@
+#ifndef TYPE_CODEC_H
+#define TYPE_CODEC_H
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace cs
+{
+	/**
+	* @brief Byte oriented LZ77 codec.
+	*
+	* A compressed stream is a sequence of literal runs, each one optionally
+	* followed by a back reference (up to 64 KiB behind) to bytes already
+	* decoded. It trades ratio for speed: a single probe per position in a small
+	* hash table, no entropy coding at all. Packed arrays of plain components
+	* (lots of zeroes, repeated fields) compress well anyway.
+	*/
+	class Codec final
+	{
+	public:
+		static void compress(const std::uint8_t* data, std::size_t size, std::vector<std::uint8_t>& out);
+		static void decompress(const std::uint8_t* data, std::size_t size, std::vector<std::uint8_t>& out);
+
+	private:
+		static void emit(std::vector<std::uint8_t>& out, const std::uint8_t* literals, std::size_t count, std::size_t offset, std::size_t length);
+		static void extend(std::vector<std::uint8_t>& out, std::size_t length);
+		static std::uint32_t read(const std::uint8_t* data);
+
+	private:
+		static const std::size_t MIN_MATCH = 4U;
+		static const std::size_t MAX_OFFSET = 0xFFFFU;
+		static const std::uint32_t HASH_BITS = 12U;
+	};
+}
+
+#endif
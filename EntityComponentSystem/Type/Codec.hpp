@@ -0,0 +1,137 @@
+#ifndef TYPE_CODEC_IMPL
+#define TYPE_CODEC_IMPL
+
+#include <cstring>
+#include <cassert>
+#include "Codec.h"
+
+namespace cs
+{
+	const std::size_t Codec::MIN_MATCH;
+	const std::size_t Codec::MAX_OFFSET;
+	const std::uint32_t Codec::HASH_BITS;
+
+	/**
+	* @brief Appends the compressed form of a buffer to the output.
+	*
+	* Tokens pack the length of the literal run in the high nibble and the
+	* length of the match (minus `MIN_MATCH`) in the low one, longer lengths
+	* spill over into the following bytes. The last token carries literals only.
+	*/
+	void Codec::compress(const std::uint8_t* data, std::size_t size, std::vector<std::uint8_t>& out) {
+		auto table = std::vector<std::size_t>(std::size_t(1) << HASH_BITS, 0U); // Positions plus one, zero is empty
+		auto anchor = std::size_t(0);
+		auto i = std::size_t(0);
+
+		out.reserve(out.size() + size / 2U + 16U);
+
+		while (i + MIN_MATCH <= size) {
+			const auto sequence = read(data + i);
+			const auto hash = (sequence * 2654435761U) >> (32U - HASH_BITS);
+			const auto candidate = table[hash];
+
+			table[hash] = i + 1U;
+
+			if (candidate && i - (candidate - 1U) <= MAX_OFFSET && read(data + candidate - 1U) == sequence) {
+				const auto match = candidate - 1U;
+				auto length = MIN_MATCH;
+
+				while (i + length < size && data[match + length] == data[i + length]) {
+					++length;
+				}
+
+				emit(out, data + anchor, i - anchor, i - match, length);
+				i += length;
+				anchor = i;
+			}
+			else {
+				++i;
+			}
+		}
+
+		emit(out, data + anchor, size - anchor, 0U, 0U);
+	}
+
+	/**
+	* @brief Appends the decompressed form of a buffer to the output.
+	*
+	* @warning
+	* Only buffers produced by `compress` are supported, corrupted ones result in
+	* undefined behavior.
+	*/
+	void Codec::decompress(const std::uint8_t* data, std::size_t size, std::vector<std::uint8_t>& out) {
+		auto i = std::size_t(0);
+
+		while (i < size) {
+			const auto token = data[i++];
+			auto count = std::size_t(token >> 4U);
+
+			if (count == 15U) {
+				for (auto byte = std::uint8_t(255U); byte == 255U; count += byte) {
+					byte = data[i++];
+				}
+			}
+
+			out.insert(out.end(), data + i, data + i + count);
+			i += count;
+
+			if (i < size) {
+				const auto offset = std::size_t(data[i]) | (std::size_t(data[i + 1U]) << 8U);
+				auto length = std::size_t(token & 15U);
+
+				i += 2U;
+
+				if (length == 15U) {
+					for (auto byte = std::uint8_t(255U); byte == 255U; length += byte) {
+						byte = data[i++];
+					}
+				}
+
+				length += MIN_MATCH;
+				assert(offset && offset <= out.size());
+
+				// Byte by byte, matches are allowed to overlap the bytes they produce
+				for (auto from = out.size() - offset; length; --length, ++from) {
+					out.push_back(out[from]);
+				}
+			}
+		}
+	}
+
+	void Codec::emit(std::vector<std::uint8_t>& out, const std::uint8_t* literals, std::size_t count, std::size_t offset, std::size_t length) {
+		const auto extra = length ? length - MIN_MATCH : std::size_t(0);
+
+		out.push_back(std::uint8_t(((count < 15U ? count : 15U) << 4U) | (extra < 15U ? extra : 15U)));
+
+		if (count >= 15U) {
+			extend(out, count - 15U);
+		}
+
+		out.insert(out.end(), literals, literals + count);
+
+		if (length) {
+			out.push_back(std::uint8_t(offset & 0xFFU));
+			out.push_back(std::uint8_t(offset >> 8U));
+
+			if (extra >= 15U) {
+				extend(out, extra - 15U);
+			}
+		}
+	}
+
+	void Codec::extend(std::vector<std::uint8_t>& out, std::size_t length) {
+		for (; length >= 255U; length -= 255U) {
+			out.push_back(255U);
+		}
+
+		out.push_back(std::uint8_t(length));
+	}
+
+	std::uint32_t Codec::read(const std::uint8_t* data) {
+		std::uint32_t value;
+		std::memcpy(&value, data, sizeof(value));
+		return value;
+	}
+}
+
+#endif
@@ -0,0 +1,62 @@
+#ifndef TYPE_COMPONENT_TYPE_H
+#define TYPE_COMPONENT_TYPE_H
+
+#include <new>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include "Family.h"
+
+namespace cs
+{
+	/**
+	* @brief Description of a type of component known at runtime only.
+	*
+	* Each description gets its own component identifier on construction, which
+	* is used in place of `ComponentFamily::uid` by any manager the type is
+	* defined in (see `EntityManager::define`). Copies share the identifier.
+	*
+	* Hooks left null stand for trivial operations: components are zero filled
+	* on default construction, copied and moved bytewise and never destroyed.
+	* Moved-from components are destroyed afterwards, as in C++.
+	*/
+	struct ComponentType
+	{
+		using Construct = void(*)(void* destination);
+		using Copy = void(*)(void* destination, const void* source);
+		using Move = void(*)(void* destination, void* source);
+		using Destroy = void(*)(void* component);
+
+		ComponentType(std::size_t size, std::size_t alignment)
+			: id(ComponentFamily::allocate())
+			, size(size)
+			, alignment(alignment)
+		{}
+
+		/**
+		* @brief Describes a C++ type, as an example to handle it along with types
+		* defined at runtime.
+		*/
+		template <typename Type>
+		static ComponentType of() {
+			auto type = ComponentType(sizeof(Type), alignof(Type));
+
+			type.construct = [](void* destination) { new (destination) Type(); };
+			type.copy = [](void* destination, const void* source) { new (destination) Type(*static_cast<const Type*>(source)); };
+			type.move = [](void* destination, void* source) { new (destination) Type(std::move(*static_cast<Type*>(source))); };
+			type.destroy = [](void* component) { static_cast<Type*>(component)->~Type(); };
+
+			return type;
+		}
+
+		std::uint32_t id;
+		std::size_t size;
+		std::size_t alignment;
+		Construct construct = nullptr;
+		Copy copy = nullptr;
+		Move move = nullptr;
+		Destroy destroy = nullptr;
+	};
+}
+
+#endif
@@ -24,6 +24,16 @@ namespace cs
 			return generate<std::decay_t<T>...>(); // Remove L/R values
 		}
 
+		/**
+		* @brief Returns an unique identifier not bound to any type.
+		*
+		* Useful for types known at runtime only, identifiers are drawn from the
+		* same sequence as the ones of the types.
+		*/
+		static std::uint32_t allocate() noexcept {
+			return id();
+		}
+
 	private:
 		static std::uint32_t id() noexcept {
 			static std::uint32_t value = 0U;
@@ -39,4 +49,5 @@ namespace cs
 
 	using ViewFamily = Family<struct ViewFamilyStruct>;
 	using ComponentFamily = Family<struct ComponentFamilyStruct>;
+	using EventFamily = Family<struct EventFamilyStruct>;
 }
\ No newline at end of file